@@ -1,5 +1,13 @@
+#include <stdlib.h>
 #include <string.h>
+#include <assert.h>
+#include <pthread.h>
 #include "array.h"
+#include "losertree.h"
+
+#define PARALLEL_THRESHOLD 65536
+#define L1_BYTES 32768
+#define BATCH_MAX 1024
 
 static void copy_elements(array_t* this, const array_t* other) {
     size_t itemSize = other->meta->itemSize;
@@ -106,6 +114,41 @@ ptrdiff_t array_find_if(const array_t* this, const size_t fromIndex, const predi
     return -1;
 }
 
+static size_t batch_length(const size_t itemSize) {
+    size_t count = L1_BYTES / itemSize;
+
+    if (0 == count) {
+        return 1;
+    }
+    else if (count > BATCH_MAX) {
+        return BATCH_MAX;
+    }
+    else {
+        return count;
+    }
+}
+
+ptrdiff_t array_find_if_batch(const array_t* this, const size_t fromIndex, const batch_predicate_t pred) {
+    size_t itemSize = this->meta->itemSize;
+    size_t batch = batch_length(itemSize);
+    bool results[BATCH_MAX];
+
+    for (ptrdiff_t index = fromIndex; index < this->length; index += batch) {
+        ptrdiff_t remaining = this->length - index;
+        size_t count = ((size_t)remaining < batch) ? (size_t)remaining : batch;
+
+        pred(array_get_const(this, index), count, itemSize, results);
+
+        for (size_t offset = 0; offset < count; ++offset) {
+            if (results[offset]) {
+                return index + offset;
+            }
+        }
+    }
+
+    return -1;
+}
+
 ptrdiff_t array_find_last(const array_t* this, const size_t fromIndex, const void* item) {
     size_t itemSize = this->meta->itemSize;
     char* ptr = (char*)(this->data) + (fromIndex * itemSize);
@@ -197,6 +240,26 @@ size_t array_count_if(const array_t* this, const predicate_t pred) {
     return amount;
 }
 
+size_t array_count_if_batch(const array_t* this, const batch_predicate_t pred) {
+    size_t itemSize = this->meta->itemSize;
+    size_t batch = batch_length(itemSize);
+    size_t amount = 0;
+    bool results[BATCH_MAX];
+
+    for (ptrdiff_t index = 0; index < this->length; index += batch) {
+        ptrdiff_t remaining = this->length - index;
+        size_t count = ((size_t)remaining < batch) ? (size_t)remaining : batch;
+
+        pred(array_get_const(this, index), count, itemSize, results);
+
+        for (size_t offset = 0; offset < count; ++offset) {
+            amount += results[offset];
+        }
+    }
+
+    return amount;
+}
+
 void array_swap(array_t* this, array_t* other) {
     void* tempData = this->data;
     this->data = other->data;
@@ -260,6 +323,96 @@ bool array_none(const array_t* this, const predicate_t pred) {
     return !array_any(this, pred);
 }
 
+bitset_t array_eval_mask(const array_t* this, const predicate_t pred) {
+    bitset_t mask;
+    bitset_init(&mask, this->length);
+
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    uint64_t* word = mask.words;
+
+    for (ptrdiff_t base = 0; base < this->length; base += 64) {
+        ptrdiff_t remaining = this->length - base;
+        size_t bits = (remaining < 64) ? remaining : 64;
+        uint64_t value = 0;
+
+        for (size_t bit = 0; bit < bits; ++bit) {
+            value |= (uint64_t)pred(ptr) << bit;
+
+            ptr += itemSize;
+        }
+
+        *word = value;
+        ++word;
+    }
+
+    return mask;
+}
+
+size_t array_compress(array_t* this, const bitset_t* mask) {
+    assert((size_t)this->length == mask->length);
+
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    char* dest = ptr;
+    destroyer_t destroyer = this->meta->destroy;
+    mover_t mover = this->meta->move;
+
+    for (ptrdiff_t index = 0; index < this->length; ++index) {
+        if (bitset_get(mask, index)) {
+            if (dest != ptr) {
+                mover(dest, ptr);
+            }
+
+            dest += itemSize;
+        }
+        else if (NULL != destroyer) {
+            destroyer(ptr);
+        }
+
+        ptr += itemSize;
+    }
+
+    this->length = (dest - (char*)(this->data)) / itemSize;
+
+    return this->length;
+}
+
+void array_select(array_t* this, const array_t* other, const bitset_t* mask) {
+    assert((size_t)other->length == mask->length);
+
+    size_t itemSize = other->meta->itemSize;
+    size_t count = bitset_count(mask);
+    copier_t copier = other->meta->copy;
+
+    this->data = other->meta->allocate(count * itemSize);
+    this->length = count;
+    this->meta = other->meta;
+
+    char* thisPtr = (char*)(this->data);
+    ptrdiff_t index = bitset_find_next(mask, 0);
+
+    while (-1 != index) {
+        copier(thisPtr, array_get_const(other, index));
+
+        thisPtr += itemSize;
+        index = bitset_find_next(mask, index + 1);
+    }
+}
+
+void array_replace_masked(array_t* this, const void* new, const bitset_t* mask) {
+    assert((size_t)this->length == mask->length);
+
+    copier_t copier = this->meta->copy;
+    ptrdiff_t index = bitset_find_next(mask, 0);
+
+    while (-1 != index) {
+        copier(array_get(this, index), new);
+
+        index = bitset_find_next(mask, index + 1);
+    }
+}
+
 ptrdiff_t array_binary_search(const array_t* this, const void* item, const comparator_t comp) {
     ptrdiff_t lowIndex = 0;
     ptrdiff_t highIndex = this->length - 1;
@@ -334,14 +487,14 @@ ptrdiff_t array_upper_bound(const array_t* this, const void* item, const compara
 
 static char* median_of_three(char* lowPtr, char* highPtr, const size_t itemSize, const comparator_t comp, void* swapBuffer) {
     size_t count = (highPtr - lowPtr) / itemSize + 1;
-    size_t midIndex = count / 2;
+    size_t midIndex = (count - 1) / 2;
     char* midPtr = lowPtr + (midIndex * itemSize);
 
     if (comp(highPtr, lowPtr) < 0) {
         ptr_swap(highPtr, lowPtr, swapBuffer, itemSize);
     }
     if (comp(midPtr, lowPtr) < 0) {
-        ptr_swap(highPtr, lowPtr, swapBuffer, itemSize);
+        ptr_swap(midPtr, lowPtr, swapBuffer, itemSize);
     }
     if (comp(highPtr, midPtr) < 0) {
         ptr_swap(highPtr, midPtr, swapBuffer, itemSize);
@@ -351,9 +504,9 @@ static char* median_of_three(char* lowPtr, char* highPtr, const size_t itemSize,
 }
 
 static char* quick_sort_partition(char* lowPtr, char* highPtr, const size_t itemSize, const comparator_t comp, void* swapBuffer) {
-    char* pivot = median_of_three(lowPtr, highPtr, itemSize, comp, swapBuffer);
+    char* pivot = (char*)swapBuffer + itemSize;
 
-    ptr_swap(pivot, lowPtr, swapBuffer, itemSize);
+    memcpy(pivot, median_of_three(lowPtr, highPtr, itemSize, comp, swapBuffer), itemSize);
 
     lowPtr -= itemSize;
     highPtr += itemSize;
@@ -379,7 +532,7 @@ static void quick_sort(char* lowPtr, char* highPtr, const size_t itemSize, const
     if (lowPtr < highPtr) {
         char* partitionPoint = quick_sort_partition(lowPtr, highPtr, itemSize, comp, swapBuffer);
 
-        quick_sort(lowPtr, partitionPoint - itemSize, itemSize, comp, swapBuffer);
+        quick_sort(lowPtr, partitionPoint, itemSize, comp, swapBuffer);
         quick_sort(partitionPoint + itemSize, highPtr, itemSize, comp, swapBuffer);
     }
 }
@@ -388,7 +541,7 @@ void array_sort(array_t* this, const comparator_t comp) {
     size_t itemSize = this->meta->itemSize;
     char* lowPtr = (char*)(this->data);
     char* highPtr = lowPtr + (this->length * itemSize);
-    void* swapBuffer = this->meta->allocate(itemSize);
+    void* swapBuffer = this->meta->allocate(2 * itemSize);
 
     quick_sort(lowPtr, highPtr - itemSize, itemSize, comp, swapBuffer);
 
@@ -454,6 +607,203 @@ void array_stable_sort(array_t* this, const comparator_t comp) {
     merge_sort(lowPtr, highPtr, itemSize, comp, this->meta->allocate, this->meta->deallocate);
 }
 
+static ptrdiff_t compare_entries(const char* left, const char* right, const comparator_t comp, const bool indirect) {
+    if (indirect) {
+        return comp(*(const void* const*)left, *(const void* const*)right);
+    }
+    else {
+        return comp(left, right);
+    }
+}
+
+static void sort_entries(char* data, const size_t count, const size_t entrySize, const comparator_t comp, const bool indirect) {
+    char* scratch = (char*)malloc(count * entrySize);
+    char* source = data;
+    char* dest = scratch;
+
+    for (size_t width = 1; width < count; width *= 2) {
+        for (size_t low = 0; low < count; low += 2 * width) {
+            size_t mid = (low + width < count) ? low + width : count;
+            size_t high = (low + 2 * width < count) ? low + 2 * width : count;
+            char* leftPtr = source + (low * entrySize);
+            char* leftEnd = source + (mid * entrySize);
+            char* rightPtr = leftEnd;
+            char* rightEnd = source + (high * entrySize);
+            char* ptr = dest + (low * entrySize);
+
+            while (leftPtr < leftEnd && rightPtr < rightEnd) {
+                if (compare_entries(leftPtr, rightPtr, comp, indirect) <= 0) {
+                    memcpy(ptr, leftPtr, entrySize);
+
+                    leftPtr += entrySize;
+                }
+                else {
+                    memcpy(ptr, rightPtr, entrySize);
+
+                    rightPtr += entrySize;
+                }
+
+                ptr += entrySize;
+            }
+
+            memcpy(ptr, leftPtr, leftEnd - leftPtr);
+            ptr += leftEnd - leftPtr;
+            memcpy(ptr, rightPtr, rightEnd - rightPtr);
+        }
+
+        char* temp = source;
+        source = dest;
+        dest = temp;
+    }
+
+    if (source != data) {
+        memcpy(data, source, count * entrySize);
+    }
+
+    free(scratch);
+}
+
+void array_argsort(const array_t* this, size_t* permutation, const comparator_t comp) {
+    size_t itemSize = this->meta->itemSize;
+    size_t count = this->length;
+    const char* base = (const char*)(this->data);
+    const char** entries = (const char**)malloc(count * sizeof(const char*));
+
+    for (size_t index = 0; index < count; ++index) {
+        entries[index] = base + (index * itemSize);
+    }
+
+    sort_entries((char*)entries, count, sizeof(const char*), comp, true);
+
+    for (size_t index = 0; index < count; ++index) {
+        permutation[index] = (entries[index] - base) / itemSize;
+    }
+
+    free(entries);
+}
+
+void array_apply_permutation(array_t* this, const size_t* permutation) {
+    size_t itemSize = this->meta->itemSize;
+    void* buffer = this->meta->allocate(itemSize);
+    bitset_t visited;
+
+    bitset_init(&visited, this->length);
+
+    for (ptrdiff_t start = 0; start < this->length; ++start) {
+        if (bitset_get(&visited, start) || permutation[start] == (size_t)start) {
+            continue;
+        }
+
+        size_t current = start;
+
+        memcpy(buffer, array_get(this, start), itemSize);
+
+        while (true) {
+            size_t next = permutation[current];
+
+            bitset_set(&visited, current, true);
+
+            if (next == (size_t)start) {
+                memcpy(array_get(this, current), buffer, itemSize);
+
+                break;
+            }
+
+            memcpy(array_get(this, current), array_get(this, next), itemSize);
+
+            current = next;
+        }
+    }
+
+    bitset_destroy(&visited);
+    this->meta->deallocate(buffer);
+}
+
+void array_sort_by_key(array_t* this, const size_t keySize, const key_extractor_t extract, const comparator_t comp) {
+    size_t count = this->length;
+    size_t indexOffset = (keySize + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+    size_t entrySize = indexOffset + sizeof(size_t);
+    char* entries = (char*)malloc(count * entrySize);
+    size_t* permutation = (size_t*)malloc(count * sizeof(size_t));
+    char* ptr = entries;
+
+    for (size_t index = 0; index < count; ++index) {
+        extract(ptr, array_get_const(this, index));
+        memcpy(ptr + indexOffset, &index, sizeof(size_t));
+
+        ptr += entrySize;
+    }
+
+    sort_entries(entries, count, entrySize, comp, false);
+
+    ptr = entries;
+
+    for (size_t index = 0; index < count; ++index) {
+        memcpy(permutation + index, ptr + indexOffset, sizeof(size_t));
+
+        ptr += entrySize;
+    }
+
+    array_apply_permutation(this, permutation);
+
+    free(permutation);
+    free(entries);
+}
+
+bool array_merge_k(array_t* this, const array_t* const* arrays, const size_t count, const comparator_t comp) {
+    if (0 == count) {
+        return false;
+    }
+
+    for (size_t index = 1; index < count; ++index) {
+        if (!array_same_type(arrays[0], arrays[index])) {
+            return false;
+        }
+    }
+
+    meta_t* meta = arrays[0]->meta;
+    size_t itemSize = meta->itemSize;
+    const void** heads = (const void**)malloc(count * sizeof(const void*));
+    const char** ends = (const char**)malloc(count * sizeof(const char*));
+    ptrdiff_t total = 0;
+    loser_tree_t tree;
+
+    for (size_t index = 0; index < count; ++index) {
+        const array_t* array = arrays[index];
+        const char* low = (const char*)(array->data);
+
+        heads[index] = (array->length > 0) ? low : NULL;
+        ends[index] = low + (array->length * itemSize);
+        total += array->length;
+    }
+
+    this->data = meta->allocate(total * itemSize);
+    this->length = total;
+    this->meta = meta;
+
+    char* ptr = (char*)(this->data);
+    ptrdiff_t winner;
+
+    loser_tree_init(&tree, heads, count, comp);
+
+    while (-1 != (winner = loser_tree_winner(&tree))) {
+        const char* head = (const char*)heads[winner] + itemSize;
+
+        meta->copy(ptr, heads[winner]);
+
+        heads[winner] = (head < ends[winner]) ? head : NULL;
+        ptr += itemSize;
+
+        loser_tree_replay(&tree);
+    }
+
+    loser_tree_destroy(&tree);
+    free(ends);
+    free(heads);
+
+    return true;
+}
+
 bool array_sorted(const array_t* this, const comparator_t comp) {
     size_t itemSize = this->meta->itemSize;
     char* ptr = (char*)(this->data);
@@ -512,104 +862,985 @@ const void* array_maximum_const(const array_t* this, const comparator_t comp) {
     return max;
 }
 
-void array_for_each(array_t* this, const action_t act) {
+minmax_t array_minmax(const array_t* this, const comparator_t comp) {
+    if (this->length <= 0) {
+        return (minmax_t){ NULL, NULL };
+    }
+
     size_t itemSize = this->meta->itemSize;
-    char* ptr = (char*)(this->data);
-    char* end = ptr + (this->length * itemSize);
+    char* min = (char*)(this->data);
+    char* max = min;
+    char* ptr = min + itemSize;
+    char* end = min + (this->length * itemSize);
 
-    while (ptr < end) {
-        act(ptr);
+    while (ptr + itemSize < end) {
+        char* next = ptr + itemSize;
+        char* small = ptr;
+        char* large = next;
 
-        ptr += itemSize;
-    }
-}
+        if (comp(next, ptr) < 0) {
+            small = next;
+            large = ptr;
+        }
 
-static size_t find_not(array_t* this, const predicate_t pred) {
-    for (size_t index = 0; index < this->length; ++index) {
-        const void* elem = array_get_const(this, index);
+        if (comp(small, min) < 0) {
+            min = small;
+        }
+        if (comp(large, max) >= 0) {
+            max = large;
+        }
 
-        if (!pred(elem)) {
-            return index;
+        ptr += 2 * itemSize;
+    }
+
+    if (ptr < end) {
+        if (comp(ptr, min) < 0) {
+            min = ptr;
+        }
+        if (comp(ptr, max) >= 0) {
+            max = ptr;
         }
     }
 
-    return this->length;
+    return (minmax_t){ min, max };
 }
 
-size_t array_partition(array_t* this, const predicate_t pred) {
-    size_t startIndex = find_not(this, pred);
+static void fold(char* ptr, char* end, const size_t itemSize, void* result, const combiner_t combine) {
+    while (ptr < end) {
+        combine(result, ptr);
 
-    if (this->length == startIndex) {
-        return startIndex;
+        ptr += itemSize;
     }
-    else {
-        size_t itemSize = this->meta->itemSize;
-        void* buffer = this->meta->allocate(itemSize);
+}
 
-        for (size_t index = startIndex + 1; index < this->length; ++index) {
-            void* elem1 = array_get(this, index);
+void array_reduce(const array_t* this, void* result, const void* identity, const combiner_t combine) {
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    char* end = ptr + (this->length * itemSize);
 
-            if (pred(elem1)) {
-                void* elem2 = array_get(this, startIndex);
+    this->meta->copy(result, identity);
 
-                ptr_swap(elem1, elem2, buffer, itemSize);
+    fold(ptr, end, itemSize, result, combine);
+}
 
-                ++startIndex;
-            }
+static void run_tasks(void* tasks, const size_t taskSize, const size_t count, void*(*worker)(void*)) {
+    pthread_t* threads = (pthread_t*)malloc(count * sizeof(pthread_t));
+    bool* started = (bool*)malloc(count * sizeof(bool));
+    char* task = (char*)tasks;
+
+    for (size_t index = 0; index < count; ++index) {
+        started[index] = (0 == pthread_create(threads + index, NULL, worker, task));
+
+        if (!started[index]) {
+            worker(task);
         }
 
-        this->meta->deallocate(buffer);
+        task += taskSize;
+    }
+
+    for (size_t index = 0; index < count; ++index) {
+        if (started[index]) {
+            pthread_join(threads[index], NULL);
+        }
     }
+
+    free(started);
+    free(threads);
 }
 
-void array_reverse(array_t* this) {
-    size_t itemSize = this->meta->itemSize;
-    char* low = (char*)(this->data);
-    char* high = low + ((this->length - 1) * itemSize);
-    void* buffer = this->meta->allocate(itemSize);
+static array_t chunk_view(const array_t* this, const size_t index, const size_t threadCount) {
+    size_t chunk = this->length / threadCount;
+    size_t length = (index == threadCount - 1) ? this->length - (index * chunk) : chunk;
+    char* data = (char*)(this->data) + (index * chunk * this->meta->itemSize);
 
-    while (low < high) {
-        ptr_swap(low, high, buffer, itemSize);
+    return (array_t){ data, length, this->meta };
+}
 
-        low += itemSize;
-        high -= itemSize;
-    }
+typedef struct {
+    char* low;
+    char* high;
+    size_t itemSize;
+    void* result;
+    combiner_t combine;
+} reduce_task_t;
 
-    this->meta->deallocate(buffer);
+static void* reduce_worker(void* arg) {
+    reduce_task_t* task = (reduce_task_t*)arg;
+
+    fold(task->low, task->high, task->itemSize, task->result, task->combine);
+
+    return NULL;
 }
 
-void array_shuffle(array_t* this, const randomizer_t random) {
+static reduce_task_t* reduce_chunks(const array_t* this, char* partials, const void* identity, const combiner_t combine, const size_t threadCount) {
     size_t itemSize = this->meta->itemSize;
-    void* buffer = this->meta->allocate(itemSize);
+    reduce_task_t* tasks = (reduce_task_t*)malloc(threadCount * sizeof(reduce_task_t));
 
-    for (size_t index = 2; index < this->length; ++index) {
-        void* ptr = array_get(this, index);
-        void* randPtr = array_get(this, random() % index);
+    for (size_t index = 0; index < threadCount; ++index) {
+        reduce_task_t* task = tasks + index;
+        array_t view = chunk_view(this, index, threadCount);
 
-        ptr_swap(ptr, randPtr, buffer, itemSize);
+        task->low = (char*)(view.data);
+        task->high = task->low + (view.length * itemSize);
+        task->itemSize = itemSize;
+        task->result = partials + (index * itemSize);
+        task->combine = combine;
+
+        this->meta->copy(task->result, identity);
     }
 
-    this->meta->deallocate(buffer);
-}
+    run_tasks(tasks, sizeof(reduce_task_t), threadCount, reduce_worker);
 
-void array_replace(array_t* this, const void* old, const void* new) {
-    size_t itemSize = this->meta->itemSize;
-    char* ptr = (char*)(this->data);
-    char* end = ptr + (this->length * itemSize);
-    binary_predicate_t equality = this->meta->equals;
-    copier_t copier = this->meta->copy;
+    return tasks;
+}
 
-    while (ptr < end) {
-        if (equality(old, ptr)) {
-            copier(ptr, new);
+static void destroy_partials(const meta_t* meta, char* partials, const size_t count) {
+    if (NULL != meta->destroy) {
+        for (size_t index = 0; index < count; ++index) {
+            meta->destroy(partials + (index * meta->itemSize));
         }
-
-        ptr += itemSize;
     }
+
+    meta->deallocate(partials);
 }
 
-void array_replace_if(array_t* this, const void* new, const predicate_t pred) {
-    size_t itemSize = this->meta->itemSize;
+void array_reduce_parallel(const array_t* this, void* result, const void* identity, const combiner_t combine, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        array_reduce(this, result, identity, combine);
+
+        return;
+    }
+
+    char* partials = (char*)this->meta->allocate(threadCount * this->meta->itemSize);
+    reduce_task_t* tasks = reduce_chunks(this, partials, identity, combine, threadCount);
+
+    this->meta->copy(result, identity);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        combine(result, tasks[index].result);
+    }
+
+    free(tasks);
+    destroy_partials(this->meta, partials, threadCount);
+}
+
+static void scan_range(char* ptr, char* end, const meta_t* meta, const void* seed, const combiner_t combine, const bool inclusive) {
+    size_t itemSize = meta->itemSize;
+    copier_t copier = meta->copy;
+    void* acc = meta->allocate(itemSize);
+    void* current = meta->allocate(itemSize);
+
+    copier(acc, seed);
+    copier(current, seed);
+
+    while (ptr < end) {
+        if (inclusive) {
+            combine(acc, ptr);
+            copier(ptr, acc);
+        }
+        else {
+            copier(current, ptr);
+            copier(ptr, acc);
+            combine(acc, current);
+        }
+
+        ptr += itemSize;
+    }
+
+    if (NULL != meta->destroy) {
+        meta->destroy(acc);
+        meta->destroy(current);
+    }
+
+    meta->deallocate(acc);
+    meta->deallocate(current);
+}
+
+void array_inclusive_scan(array_t* this, const combiner_t combine) {
+    if (this->length <= 0) {
+        return;
+    }
+
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    char* end = ptr + (this->length * itemSize);
+
+    scan_range(ptr + itemSize, end, this->meta, ptr, combine, true);
+}
+
+void array_exclusive_scan(array_t* this, const void* identity, const combiner_t combine) {
+    char* ptr = (char*)(this->data);
+    char* end = ptr + (this->length * this->meta->itemSize);
+
+    scan_range(ptr, end, this->meta, identity, combine, false);
+}
+
+typedef struct {
+    array_t view;
+    const void* seed;
+    combiner_t combine;
+    bool inclusive;
+} scan_task_t;
+
+static void* scan_worker(void* arg) {
+    scan_task_t* task = (scan_task_t*)arg;
+    char* ptr = (char*)(task->view.data);
+    char* end = ptr + (task->view.length * task->view.meta->itemSize);
+
+    scan_range(ptr, end, task->view.meta, task->seed, task->combine, task->inclusive);
+
+    return NULL;
+}
+
+static void scan_parallel(array_t* this, const void* identity, const combiner_t combine, const size_t threadCount, const bool inclusive) {
+    size_t itemSize = this->meta->itemSize;
+    char* totals = (char*)this->meta->allocate(threadCount * itemSize);
+    char* seeds = (char*)this->meta->allocate(threadCount * itemSize);
+    void* running = this->meta->allocate(itemSize);
+    reduce_task_t* reduceTasks = reduce_chunks(this, totals, identity, combine, threadCount);
+    scan_task_t* scanTasks = (scan_task_t*)malloc(threadCount * sizeof(scan_task_t));
+
+    this->meta->copy(running, identity);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        scan_task_t* task = scanTasks + index;
+        char* seed = seeds + (index * itemSize);
+
+        this->meta->copy(seed, running);
+        combine(running, totals + (index * itemSize));
+
+        task->view = chunk_view(this, index, threadCount);
+        task->seed = seed;
+        task->combine = combine;
+        task->inclusive = inclusive;
+    }
+
+    run_tasks(scanTasks, sizeof(scan_task_t), threadCount, scan_worker);
+
+    if (NULL != this->meta->destroy) {
+        this->meta->destroy(running);
+    }
+
+    free(scanTasks);
+    free(reduceTasks);
+    this->meta->deallocate(running);
+    destroy_partials(this->meta, seeds, threadCount);
+    destroy_partials(this->meta, totals, threadCount);
+}
+
+void array_inclusive_scan_parallel(array_t* this, const void* identity, const combiner_t combine, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        array_inclusive_scan(this, combine);
+    }
+    else {
+        scan_parallel(this, identity, combine, threadCount, true);
+    }
+}
+
+void array_exclusive_scan_parallel(array_t* this, const void* identity, const combiner_t combine, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        array_exclusive_scan(this, identity, combine);
+    }
+    else {
+        scan_parallel(this, identity, combine, threadCount, false);
+    }
+}
+
+long long array_sum_int(const array_t* this) {
+    assert(sizeof(int) == this->meta->itemSize);
+
+    const int* data = (const int*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    long long acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 += data[index];
+        acc1 += data[index + 1];
+        acc2 += data[index + 2];
+        acc3 += data[index + 3];
+    }
+
+    for (; index < length; ++index) {
+        acc0 += data[index];
+    }
+
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+long long array_product_int(const array_t* this) {
+    assert(sizeof(int) == this->meta->itemSize);
+
+    const int* data = (const int*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    unsigned long long acc0 = 1, acc1 = 1, acc2 = 1, acc3 = 1;
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 *= (unsigned long long)data[index];
+        acc1 *= (unsigned long long)data[index + 1];
+        acc2 *= (unsigned long long)data[index + 2];
+        acc3 *= (unsigned long long)data[index + 3];
+    }
+
+    for (; index < length; ++index) {
+        acc0 *= (unsigned long long)data[index];
+    }
+
+    return (long long)((acc0 * acc1) * (acc2 * acc3));
+}
+
+double array_sum_double(const array_t* this) {
+    assert(sizeof(double) == this->meta->itemSize);
+
+    const double* data = (const double*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    double acc0 = 0.0, acc1 = 0.0, acc2 = 0.0, acc3 = 0.0;
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 += data[index];
+        acc1 += data[index + 1];
+        acc2 += data[index + 2];
+        acc3 += data[index + 3];
+    }
+
+    for (; index < length; ++index) {
+        acc0 += data[index];
+    }
+
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+double array_product_double(const array_t* this) {
+    assert(sizeof(double) == this->meta->itemSize);
+
+    const double* data = (const double*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    double acc0 = 1.0, acc1 = 1.0, acc2 = 1.0, acc3 = 1.0;
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 *= data[index];
+        acc1 *= data[index + 1];
+        acc2 *= data[index + 2];
+        acc3 *= data[index + 3];
+    }
+
+    for (; index < length; ++index) {
+        acc0 *= data[index];
+    }
+
+    return (acc0 * acc1) * (acc2 * acc3);
+}
+
+bool array_min_int(const array_t* this, int* result) {
+    assert(sizeof(int) == this->meta->itemSize);
+
+    if (this->length <= 0) {
+        return false;
+    }
+
+    const int* data = (const int*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    int acc0 = data[0], acc1 = data[0], acc2 = data[0], acc3 = data[0];
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 = (data[index] < acc0) ? data[index] : acc0;
+        acc1 = (data[index + 1] < acc1) ? data[index + 1] : acc1;
+        acc2 = (data[index + 2] < acc2) ? data[index + 2] : acc2;
+        acc3 = (data[index + 3] < acc3) ? data[index + 3] : acc3;
+    }
+
+    for (; index < length; ++index) {
+        acc0 = (data[index] < acc0) ? data[index] : acc0;
+    }
+
+    acc0 = (acc1 < acc0) ? acc1 : acc0;
+    acc2 = (acc3 < acc2) ? acc3 : acc2;
+
+    *result = (acc2 < acc0) ? acc2 : acc0;
+
+    return true;
+}
+
+bool array_max_int(const array_t* this, int* result) {
+    assert(sizeof(int) == this->meta->itemSize);
+
+    if (this->length <= 0) {
+        return false;
+    }
+
+    const int* data = (const int*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    int acc0 = data[0], acc1 = data[0], acc2 = data[0], acc3 = data[0];
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 = (data[index] > acc0) ? data[index] : acc0;
+        acc1 = (data[index + 1] > acc1) ? data[index + 1] : acc1;
+        acc2 = (data[index + 2] > acc2) ? data[index + 2] : acc2;
+        acc3 = (data[index + 3] > acc3) ? data[index + 3] : acc3;
+    }
+
+    for (; index < length; ++index) {
+        acc0 = (data[index] > acc0) ? data[index] : acc0;
+    }
+
+    acc0 = (acc1 > acc0) ? acc1 : acc0;
+    acc2 = (acc3 > acc2) ? acc3 : acc2;
+
+    *result = (acc2 > acc0) ? acc2 : acc0;
+
+    return true;
+}
+
+bool array_min_double(const array_t* this, double* result) {
+    assert(sizeof(double) == this->meta->itemSize);
+
+    if (this->length <= 0) {
+        return false;
+    }
+
+    const double* data = (const double*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    double acc0 = data[0], acc1 = data[0], acc2 = data[0], acc3 = data[0];
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 = (data[index] < acc0) ? data[index] : acc0;
+        acc1 = (data[index + 1] < acc1) ? data[index + 1] : acc1;
+        acc2 = (data[index + 2] < acc2) ? data[index + 2] : acc2;
+        acc3 = (data[index + 3] < acc3) ? data[index + 3] : acc3;
+    }
+
+    for (; index < length; ++index) {
+        acc0 = (data[index] < acc0) ? data[index] : acc0;
+    }
+
+    acc0 = (acc1 < acc0) ? acc1 : acc0;
+    acc2 = (acc3 < acc2) ? acc3 : acc2;
+
+    *result = (acc2 < acc0) ? acc2 : acc0;
+
+    return true;
+}
+
+bool array_max_double(const array_t* this, double* result) {
+    assert(sizeof(double) == this->meta->itemSize);
+
+    if (this->length <= 0) {
+        return false;
+    }
+
+    const double* data = (const double*)(this->data);
+    ptrdiff_t length = this->length;
+    ptrdiff_t index = 0;
+    double acc0 = data[0], acc1 = data[0], acc2 = data[0], acc3 = data[0];
+
+    for (; index + 4 <= length; index += 4) {
+        acc0 = (data[index] > acc0) ? data[index] : acc0;
+        acc1 = (data[index + 1] > acc1) ? data[index + 1] : acc1;
+        acc2 = (data[index + 2] > acc2) ? data[index + 2] : acc2;
+        acc3 = (data[index + 3] > acc3) ? data[index + 3] : acc3;
+    }
+
+    for (; index < length; ++index) {
+        acc0 = (data[index] > acc0) ? data[index] : acc0;
+    }
+
+    acc0 = (acc1 > acc0) ? acc1 : acc0;
+    acc2 = (acc3 > acc2) ? acc3 : acc2;
+
+    *result = (acc2 > acc0) ? acc2 : acc0;
+
+    return true;
+}
+
+typedef void(*kernel_t)(const array_t*, void*);
+
+typedef struct {
+    array_t view;
+    kernel_t kernel;
+    void* result;
+} kernel_task_t;
+
+typedef struct {
+    bool found;
+    int value;
+} int_extreme_t;
+
+typedef struct {
+    bool found;
+    double value;
+} double_extreme_t;
+
+static void* kernel_worker(void* arg) {
+    kernel_task_t* task = (kernel_task_t*)arg;
+
+    task->kernel(&task->view, task->result);
+
+    return NULL;
+}
+
+static void run_kernel(const array_t* this, const kernel_t kernel, void* partials, const size_t partialSize, const size_t threadCount) {
+    kernel_task_t* tasks = (kernel_task_t*)malloc(threadCount * sizeof(kernel_task_t));
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        tasks[index].view = chunk_view(this, index, threadCount);
+        tasks[index].kernel = kernel;
+        tasks[index].result = (char*)partials + (index * partialSize);
+    }
+
+    run_tasks(tasks, sizeof(kernel_task_t), threadCount, kernel_worker);
+
+    free(tasks);
+}
+
+static void sum_int_kernel(const array_t* view, void* result) {
+    *(long long*)result = array_sum_int(view);
+}
+
+long long array_sum_int_parallel(const array_t* this, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_sum_int(this);
+    }
+
+    long long* partials = (long long*)malloc(threadCount * sizeof(long long));
+    long long acc = 0;
+
+    run_kernel(this, sum_int_kernel, partials, sizeof(long long), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        acc += partials[index];
+    }
+
+    free(partials);
+
+    return acc;
+}
+
+static void product_int_kernel(const array_t* view, void* result) {
+    *(long long*)result = array_product_int(view);
+}
+
+long long array_product_int_parallel(const array_t* this, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_product_int(this);
+    }
+
+    long long* partials = (long long*)malloc(threadCount * sizeof(long long));
+    unsigned long long acc = 1;
+
+    run_kernel(this, product_int_kernel, partials, sizeof(long long), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        acc *= (unsigned long long)partials[index];
+    }
+
+    free(partials);
+
+    return (long long)acc;
+}
+
+static void sum_double_kernel(const array_t* view, void* result) {
+    *(double*)result = array_sum_double(view);
+}
+
+double array_sum_double_parallel(const array_t* this, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_sum_double(this);
+    }
+
+    double* partials = (double*)malloc(threadCount * sizeof(double));
+    double acc = 0.0;
+
+    run_kernel(this, sum_double_kernel, partials, sizeof(double), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        acc += partials[index];
+    }
+
+    free(partials);
+
+    return acc;
+}
+
+static void product_double_kernel(const array_t* view, void* result) {
+    *(double*)result = array_product_double(view);
+}
+
+double array_product_double_parallel(const array_t* this, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_product_double(this);
+    }
+
+    double* partials = (double*)malloc(threadCount * sizeof(double));
+    double acc = 1.0;
+
+    run_kernel(this, product_double_kernel, partials, sizeof(double), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        acc *= partials[index];
+    }
+
+    free(partials);
+
+    return acc;
+}
+
+static void min_int_kernel(const array_t* view, void* result) {
+    int_extreme_t* extreme = (int_extreme_t*)result;
+
+    extreme->found = array_min_int(view, &extreme->value);
+}
+
+bool array_min_int_parallel(const array_t* this, int* result, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_min_int(this, result);
+    }
+
+    int_extreme_t* partials = (int_extreme_t*)malloc(threadCount * sizeof(int_extreme_t));
+    bool found = false;
+
+    run_kernel(this, min_int_kernel, partials, sizeof(int_extreme_t), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        if (partials[index].found && (!found || partials[index].value < *result)) {
+            *result = partials[index].value;
+            found = true;
+        }
+    }
+
+    free(partials);
+
+    return found;
+}
+
+static void max_int_kernel(const array_t* view, void* result) {
+    int_extreme_t* extreme = (int_extreme_t*)result;
+
+    extreme->found = array_max_int(view, &extreme->value);
+}
+
+bool array_max_int_parallel(const array_t* this, int* result, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_max_int(this, result);
+    }
+
+    int_extreme_t* partials = (int_extreme_t*)malloc(threadCount * sizeof(int_extreme_t));
+    bool found = false;
+
+    run_kernel(this, max_int_kernel, partials, sizeof(int_extreme_t), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        if (partials[index].found && (!found || partials[index].value > *result)) {
+            *result = partials[index].value;
+            found = true;
+        }
+    }
+
+    free(partials);
+
+    return found;
+}
+
+static void min_double_kernel(const array_t* view, void* result) {
+    double_extreme_t* extreme = (double_extreme_t*)result;
+
+    extreme->found = array_min_double(view, &extreme->value);
+}
+
+bool array_min_double_parallel(const array_t* this, double* result, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_min_double(this, result);
+    }
+
+    double_extreme_t* partials = (double_extreme_t*)malloc(threadCount * sizeof(double_extreme_t));
+    bool found = false;
+
+    run_kernel(this, min_double_kernel, partials, sizeof(double_extreme_t), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        if (partials[index].found && (!found || partials[index].value < *result)) {
+            *result = partials[index].value;
+            found = true;
+        }
+    }
+
+    free(partials);
+
+    return found;
+}
+
+static void max_double_kernel(const array_t* view, void* result) {
+    double_extreme_t* extreme = (double_extreme_t*)result;
+
+    extreme->found = array_max_double(view, &extreme->value);
+}
+
+bool array_max_double_parallel(const array_t* this, double* result, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        return array_max_double(this, result);
+    }
+
+    double_extreme_t* partials = (double_extreme_t*)malloc(threadCount * sizeof(double_extreme_t));
+    bool found = false;
+
+    run_kernel(this, max_double_kernel, partials, sizeof(double_extreme_t), threadCount);
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        if (partials[index].found && (!found || partials[index].value > *result)) {
+            *result = partials[index].value;
+            found = true;
+        }
+    }
+
+    free(partials);
+
+    return found;
+}
+
+void array_for_each(array_t* this, const action_t act) {
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    char* end = ptr + (this->length * itemSize);
+
+    while (ptr < end) {
+        act(ptr);
+
+        ptr += itemSize;
+    }
+}
+
+void array_for_each_batch(array_t* this, const batch_action_t act) {
+    size_t itemSize = this->meta->itemSize;
+    size_t batch = batch_length(itemSize);
+
+    for (ptrdiff_t index = 0; index < this->length; index += batch) {
+        ptrdiff_t remaining = this->length - index;
+        size_t count = ((size_t)remaining < batch) ? (size_t)remaining : batch;
+
+        act(array_get(this, index), count, itemSize);
+    }
+}
+
+static size_t find_not(array_t* this, const predicate_t pred) {
+    for (size_t index = 0; index < this->length; ++index) {
+        const void* elem = array_get_const(this, index);
+
+        if (!pred(elem)) {
+            return index;
+        }
+    }
+
+    return this->length;
+}
+
+size_t array_partition(array_t* this, const predicate_t pred) {
+    size_t startIndex = find_not(this, pred);
+
+    if (this->length == startIndex) {
+        return startIndex;
+    }
+    else {
+        size_t itemSize = this->meta->itemSize;
+        void* buffer = this->meta->allocate(itemSize);
+
+        for (size_t index = startIndex + 1; index < this->length; ++index) {
+            void* elem1 = array_get(this, index);
+
+            if (pred(elem1)) {
+                void* elem2 = array_get(this, startIndex);
+
+                ptr_swap(elem1, elem2, buffer, itemSize);
+
+                ++startIndex;
+            }
+        }
+
+        this->meta->deallocate(buffer);
+    }
+}
+
+void array_reverse(array_t* this) {
+    size_t itemSize = this->meta->itemSize;
+    char* low = (char*)(this->data);
+    char* high = low + ((this->length - 1) * itemSize);
+    void* buffer = this->meta->allocate(itemSize);
+
+    while (low < high) {
+        ptr_swap(low, high, buffer, itemSize);
+
+        low += itemSize;
+        high -= itemSize;
+    }
+
+    this->meta->deallocate(buffer);
+}
+
+static void fisher_yates(char* data, const size_t length, const size_t itemSize, rng_t* rng, void* buffer) {
+    for (size_t index = length; index > 1; --index) {
+        char* ptr = data + ((index - 1) * itemSize);
+        char* randPtr = data + (rng_bounded(rng, index) * itemSize);
+
+        if (ptr != randPtr) {
+            ptr_swap(ptr, randPtr, buffer, itemSize);
+        }
+    }
+}
+
+void array_shuffle(array_t* this, rng_t* rng) {
+    size_t itemSize = this->meta->itemSize;
+    void* buffer = this->meta->allocate(itemSize);
+
+    fisher_yates((char*)(this->data), this->length, itemSize, rng, buffer);
+
+    this->meta->deallocate(buffer);
+}
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t itemSize;
+    rng_t rng;
+    void* buffer;
+} shuffle_task_t;
+
+static void* shuffle_worker(void* arg) {
+    shuffle_task_t* task = (shuffle_task_t*)arg;
+
+    fisher_yates(task->data, task->length, task->itemSize, &task->rng, task->buffer);
+
+    return NULL;
+}
+
+void array_shuffle_parallel(array_t* this, rng_t* rng, const size_t threadCount) {
+    if (threadCount <= 1 || this->length < PARALLEL_THRESHOLD) {
+        array_shuffle(this, rng);
+
+        return;
+    }
+
+    size_t itemSize = this->meta->itemSize;
+    size_t length = this->length;
+    char* data = (char*)(this->data);
+    char* scattered = (char*)this->meta->allocate(length * itemSize);
+    char* swapBuffers = (char*)this->meta->allocate(threadCount * itemSize);
+    uint32_t* buckets = (uint32_t*)malloc(length * sizeof(uint32_t));
+    size_t* offsets = (size_t*)calloc(threadCount + 1, sizeof(size_t));
+    shuffle_task_t* tasks = (shuffle_task_t*)malloc(threadCount * sizeof(shuffle_task_t));
+
+    for (size_t index = 0; index < length; ++index) {
+        buckets[index] = (uint32_t)rng_bounded(rng, threadCount);
+
+        ++offsets[buckets[index] + 1];
+    }
+
+    for (size_t index = 1; index <= threadCount; ++index) {
+        offsets[index] += offsets[index - 1];
+    }
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        shuffle_task_t* task = tasks + index;
+
+        task->data = scattered + (offsets[index] * itemSize);
+        task->length = offsets[index + 1] - offsets[index];
+        task->itemSize = itemSize;
+        task->buffer = swapBuffers + (index * itemSize);
+
+        rng_split(rng, &task->rng);
+    }
+
+    for (size_t index = 0; index < length; ++index) {
+        memcpy(scattered + (offsets[buckets[index]] * itemSize), data + (index * itemSize), itemSize);
+
+        ++offsets[buckets[index]];
+    }
+
+    run_tasks(tasks, sizeof(shuffle_task_t), threadCount, shuffle_worker);
+
+    memcpy(data, scattered, length * itemSize);
+
+    free(tasks);
+    free(offsets);
+    free(buckets);
+    this->meta->deallocate(swapBuffers);
+    this->meta->deallocate(scattered);
+}
+
+void array_sample(array_t* this, const array_t* other, const size_t count, rng_t* rng) {
+    size_t length = other->length;
+    size_t amount = (count < length) ? count : length;
+    bitset_t selected;
+
+    bitset_init(&selected, length);
+
+    for (size_t index = length - amount; index < length; ++index) {
+        size_t pick = rng_bounded(rng, index + 1);
+
+        if (bitset_get(&selected, pick)) {
+            bitset_set(&selected, index, true);
+        }
+        else {
+            bitset_set(&selected, pick, true);
+        }
+    }
+
+    array_select(this, other, &selected);
+
+    bitset_destroy(&selected);
+}
+
+void array_sample_reservoir(array_t* this, const array_t* other, const size_t count, rng_t* rng) {
+    size_t length = other->length;
+    size_t amount = (count < length) ? count : length;
+    size_t* reservoir = (size_t*)malloc(amount * sizeof(size_t));
+    bitset_t selected;
+
+    for (size_t index = 0; index < amount; ++index) {
+        reservoir[index] = index;
+    }
+
+    for (size_t index = amount; index < length; ++index) {
+        size_t pick = rng_bounded(rng, index + 1);
+
+        if (pick < amount) {
+            reservoir[pick] = index;
+        }
+    }
+
+    bitset_init(&selected, length);
+
+    for (size_t index = 0; index < amount; ++index) {
+        bitset_set(&selected, reservoir[index], true);
+    }
+
+    array_select(this, other, &selected);
+
+    bitset_destroy(&selected);
+    free(reservoir);
+}
+
+void array_replace(array_t* this, const void* old, const void* new) {
+    size_t itemSize = this->meta->itemSize;
+    char* ptr = (char*)(this->data);
+    char* end = ptr + (this->length * itemSize);
+    binary_predicate_t equality = this->meta->equals;
+    copier_t copier = this->meta->copy;
+
+    while (ptr < end) {
+        if (equality(old, ptr)) {
+            copier(ptr, new);
+        }
+
+        ptr += itemSize;
+    }
+}
+
+void array_replace_if(array_t* this, const void* new, const predicate_t pred) {
+    size_t itemSize = this->meta->itemSize;
     char* ptr = (char*)(this->data);
     char* end = ptr + (this->length * itemSize);
     copier_t copier = this->meta->copy;
@@ -623,6 +1854,29 @@ void array_replace_if(array_t* this, const void* new, const predicate_t pred) {
     }
 }
 
+void array_replace_if_batch(array_t* this, const void* new, const batch_predicate_t pred) {
+    size_t itemSize = this->meta->itemSize;
+    size_t batch = batch_length(itemSize);
+    copier_t copier = this->meta->copy;
+    bool results[BATCH_MAX];
+
+    for (ptrdiff_t index = 0; index < this->length; index += batch) {
+        ptrdiff_t remaining = this->length - index;
+        size_t count = ((size_t)remaining < batch) ? (size_t)remaining : batch;
+        char* ptr = (char*)array_get(this, index);
+
+        pred(ptr, count, itemSize, results);
+
+        for (size_t offset = 0; offset < count; ++offset) {
+            if (results[offset]) {
+                copier(ptr, new);
+            }
+
+            ptr += itemSize;
+        }
+    }
+}
+
 bool array_equals(const array_t* this, const array_t* other) {
     if (this->length != other->length || this->meta != other->meta) {
         return false;
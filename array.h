@@ -5,6 +5,8 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "utils.h"
+#include "bitset.h"
+#include "random.h"
 
 typedef struct {
     void* data;
@@ -32,6 +34,8 @@ ptrdiff_t array_find(const array_t*, const size_t, const void*);
 
 ptrdiff_t array_find_if(const array_t*, const size_t, const predicate_t);
 
+ptrdiff_t array_find_if_batch(const array_t*, const size_t, const batch_predicate_t);
+
 ptrdiff_t array_find_last(const array_t*, const size_t, const void*);
 
 ptrdiff_t array_find_last_if(const array_t*, const size_t, const predicate_t);
@@ -42,6 +46,8 @@ size_t array_count(const array_t*, const void*);
 
 size_t array_count_if(const array_t*, const predicate_t);
 
+size_t array_count_if_batch(const array_t*, const batch_predicate_t);
+
 void array_swap(array_t*, array_t*);
 
 void array_fill(array_t*, const void*);
@@ -52,6 +58,14 @@ bool array_any(const array_t*, const predicate_t);
 
 bool array_none(const array_t*, const predicate_t);
 
+bitset_t array_eval_mask(const array_t*, const predicate_t);
+
+size_t array_compress(array_t*, const bitset_t*);
+
+void array_select(array_t*, const array_t*, const bitset_t*);
+
+void array_replace_masked(array_t*, const void*, const bitset_t*);
+
 ptrdiff_t array_binary_search(const array_t*, const void*, const comparator_t);
 
 ptrdiff_t array_lower_bound(const array_t*, const void*, const comparator_t);
@@ -62,6 +76,14 @@ void array_sort(array_t*, const comparator_t);
 
 void array_stable_sort(array_t*, const comparator_t);
 
+void array_argsort(const array_t*, size_t*, const comparator_t);
+
+void array_apply_permutation(array_t*, const size_t*);
+
+void array_sort_by_key(array_t*, const size_t, const key_extractor_t, const comparator_t);
+
+bool array_merge_k(array_t*, const array_t* const*, const size_t, const comparator_t);
+
 bool array_sorted(const array_t*, const comparator_t);
 
 void* array_minimum(array_t*, const comparator_t);
@@ -72,18 +94,75 @@ void* array_maximum(array_t*, const comparator_t);
 
 const void* array_maximum_const(const array_t*, const comparator_t);
 
+minmax_t array_minmax(const array_t*, const comparator_t);
+
+void array_reduce(const array_t*, void*, const void*, const combiner_t);
+
+void array_reduce_parallel(const array_t*, void*, const void*, const combiner_t, const size_t);
+
+void array_inclusive_scan(array_t*, const combiner_t);
+
+void array_inclusive_scan_parallel(array_t*, const void*, const combiner_t, const size_t);
+
+void array_exclusive_scan(array_t*, const void*, const combiner_t);
+
+void array_exclusive_scan_parallel(array_t*, const void*, const combiner_t, const size_t);
+
+long long array_sum_int(const array_t*);
+
+long long array_sum_int_parallel(const array_t*, const size_t);
+
+// Wraps modulo 2^64 on overflow instead of invoking undefined behaviour.
+long long array_product_int(const array_t*);
+
+long long array_product_int_parallel(const array_t*, const size_t);
+
+double array_sum_double(const array_t*);
+
+double array_sum_double_parallel(const array_t*, const size_t);
+
+double array_product_double(const array_t*);
+
+double array_product_double_parallel(const array_t*, const size_t);
+
+bool array_min_int(const array_t*, int*);
+
+bool array_min_int_parallel(const array_t*, int*, const size_t);
+
+bool array_max_int(const array_t*, int*);
+
+bool array_max_int_parallel(const array_t*, int*, const size_t);
+
+bool array_min_double(const array_t*, double*);
+
+bool array_min_double_parallel(const array_t*, double*, const size_t);
+
+bool array_max_double(const array_t*, double*);
+
+bool array_max_double_parallel(const array_t*, double*, const size_t);
+
 void array_for_each(array_t*, const action_t);
 
+void array_for_each_batch(array_t*, const batch_action_t);
+
 size_t array_partition(array_t*, const predicate_t);
 
 void array_reverse(array_t*);
 
-void array_shuffle(array_t*, const randomizer_t);
+void array_shuffle(array_t*, rng_t*);
+
+void array_shuffle_parallel(array_t*, rng_t*, const size_t);
+
+void array_sample(array_t*, const array_t*, const size_t, rng_t*);
+
+void array_sample_reservoir(array_t*, const array_t*, const size_t, rng_t*);
 
 void array_replace(array_t*, const void*, const void*);
 
 void array_replace_if(array_t*, const void*, const predicate_t);
 
+void array_replace_if_batch(array_t*, const void*, const batch_predicate_t);
+
 bool array_equals(const array_t*, const array_t*);
 
 comparison_t array_compare(const array_t*, const array_t*, const comparator_t);
@@ -0,0 +1,150 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "bitset.h"
+
+#define WORD_BITS 64
+
+static size_t word_count(const size_t length) {
+    return (length + WORD_BITS - 1) / WORD_BITS;
+}
+
+static uint64_t tail_mask(const size_t length) {
+    size_t rem = length % WORD_BITS;
+
+    return (0 == rem) ? UINT64_MAX : (((uint64_t)1 << rem) - 1);
+}
+
+void bitset_init(bitset_t* this, const size_t length) {
+    this->words = (uint64_t*)calloc(word_count(length), sizeof(uint64_t));
+    this->length = length;
+}
+
+void bitset_copy(bitset_t* this, const bitset_t* other) {
+    size_t size = word_count(other->length) * sizeof(uint64_t);
+
+    bitset_destroy(this);
+    bitset_init(this, other->length);
+
+    memcpy(this->words, other->words, size);
+}
+
+void bitset_move(bitset_t* this, bitset_t* other) {
+    this->words = other->words;
+    this->length = other->length;
+
+    other->words = NULL;
+    other->length = 0;
+}
+
+void bitset_destroy(bitset_t* this) {
+    free(this->words);
+
+    this->words = NULL;
+    this->length = 0;
+}
+
+bool bitset_get(const bitset_t* this, const size_t index) {
+    return (this->words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+void bitset_set(bitset_t* this, const size_t index, const bool value) {
+    uint64_t bit = (uint64_t)1 << (index % WORD_BITS);
+    uint64_t* word = this->words + (index / WORD_BITS);
+
+    if (value) {
+        *word |= bit;
+    }
+    else {
+        *word &= ~bit;
+    }
+}
+
+void bitset_flip(bitset_t* this) {
+    size_t count = word_count(this->length);
+
+    for (size_t index = 0; index < count; ++index) {
+        this->words[index] = ~this->words[index];
+    }
+
+    if (count > 0) {
+        this->words[count - 1] &= tail_mask(this->length);
+    }
+}
+
+void bitset_and(bitset_t* this, const bitset_t* other) {
+    assert(this->length == other->length);
+
+    size_t count = word_count(this->length);
+
+    for (size_t index = 0; index < count; ++index) {
+        this->words[index] &= other->words[index];
+    }
+}
+
+void bitset_or(bitset_t* this, const bitset_t* other) {
+    assert(this->length == other->length);
+
+    size_t count = word_count(this->length);
+
+    for (size_t index = 0; index < count; ++index) {
+        this->words[index] |= other->words[index];
+    }
+}
+
+size_t bitset_count(const bitset_t* this) {
+    size_t count = word_count(this->length);
+    size_t amount = 0;
+
+    for (size_t index = 0; index < count; ++index) {
+        amount += __builtin_popcountll(this->words[index]);
+    }
+
+    return amount;
+}
+
+ptrdiff_t bitset_find_next(const bitset_t* this, const size_t fromIndex) {
+    if (fromIndex >= this->length) {
+        return -1;
+    }
+
+    size_t count = word_count(this->length);
+    size_t wordIndex = fromIndex / WORD_BITS;
+    uint64_t word = this->words[wordIndex] & (UINT64_MAX << (fromIndex % WORD_BITS));
+
+    while (true) {
+        if (0 != word) {
+            size_t index = wordIndex * WORD_BITS + __builtin_ctzll(word);
+
+            return (index < this->length) ? (ptrdiff_t)index : -1;
+        }
+
+        ++wordIndex;
+
+        if (wordIndex >= count) {
+            return -1;
+        }
+
+        word = this->words[wordIndex];
+    }
+}
+
+bool bitset_all(const bitset_t* this) {
+    return this->length == bitset_count(this);
+}
+
+bool bitset_any(const bitset_t* this) {
+    size_t count = word_count(this->length);
+
+    for (size_t index = 0; index < count; ++index) {
+        if (0 != this->words[index]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool bitset_none(const bitset_t* this) {
+    return !bitset_any(this);
+}
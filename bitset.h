@@ -0,0 +1,43 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint64_t* words;
+    size_t length;
+} bitset_t;
+
+void bitset_init(bitset_t*, const size_t);
+
+void bitset_copy(bitset_t*, const bitset_t*);
+
+void bitset_move(bitset_t*, bitset_t*);
+
+void bitset_destroy(bitset_t*);
+
+bool bitset_get(const bitset_t*, const size_t);
+
+void bitset_set(bitset_t*, const size_t, const bool);
+
+void bitset_flip(bitset_t*);
+
+void bitset_and(bitset_t*, const bitset_t*);
+
+void bitset_or(bitset_t*, const bitset_t*);
+
+size_t bitset_count(const bitset_t*);
+
+ptrdiff_t bitset_find_next(const bitset_t*, const size_t);
+
+bool bitset_all(const bitset_t*);
+
+bool bitset_any(const bitset_t*);
+
+bool bitset_none(const bitset_t*);
+
+
+#endif
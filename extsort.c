@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "extsort.h"
+#include "array.h"
+#include "losertree.h"
+
+#define DEFAULT_MEMORY_BUDGET (64 * 1024 * 1024)
+#define DEFAULT_BUFFER_SIZE (1024 * 1024)
+#define DEFAULT_MAX_FAN_IN 16
+#define DEFAULT_TEMP_DIRECTORY "/tmp"
+
+typedef struct {
+    char** paths;
+    size_t count;
+    size_t capacity;
+} run_list_t;
+
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t capacity;
+    size_t count;
+    size_t position;
+} run_reader_t;
+
+void extsort_config_init(extsort_config_t* this) {
+    this->memoryBudget = DEFAULT_MEMORY_BUDGET;
+    this->bufferSize = DEFAULT_BUFFER_SIZE;
+    this->maxFanIn = DEFAULT_MAX_FAN_IN;
+    this->tempDirectory = DEFAULT_TEMP_DIRECTORY;
+}
+
+static FILE* create_run(const char* directory, char** path) {
+    size_t length = snprintf(NULL, 0, "%s/extsort_XXXXXX", directory) + 1;
+
+    *path = (char*)malloc(length);
+    snprintf(*path, length, "%s/extsort_XXXXXX", directory);
+
+    int descriptor = mkstemp(*path);
+    FILE* file = NULL;
+
+    if (-1 != descriptor) {
+        file = fdopen(descriptor, "wb");
+
+        if (NULL == file) {
+            close(descriptor);
+            unlink(*path);
+        }
+    }
+
+    if (NULL == file) {
+        free(*path);
+        *path = NULL;
+    }
+
+    return file;
+}
+
+static void run_list_push(run_list_t* this, char* path) {
+    if (this->count == this->capacity) {
+        this->capacity = (0 == this->capacity) ? 8 : 2 * this->capacity;
+        this->paths = (char**)realloc(this->paths, this->capacity * sizeof(char*));
+    }
+
+    this->paths[this->count] = path;
+    ++this->count;
+}
+
+static void run_list_clear(run_list_t* this) {
+    for (size_t index = 0; index < this->count; ++index) {
+        unlink(this->paths[index]);
+        free(this->paths[index]);
+    }
+
+    free(this->paths);
+
+    this->paths = NULL;
+    this->count = 0;
+    this->capacity = 0;
+}
+
+static bool create_runs(FILE* input, run_list_t* runs, meta_t* meta, const comparator_t comp, const extsort_config_t* config) {
+    size_t itemSize = meta->itemSize;
+    size_t capacity = config->memoryBudget / itemSize;
+    array_t chunk = { meta->allocate((capacity > 0 ? capacity : 1) * itemSize), 0, meta };
+    bool succeeded = true;
+
+    if (0 == capacity) {
+        capacity = 1;
+    }
+
+    while (succeeded) {
+        size_t bytes = fread(chunk.data, 1, capacity * itemSize, input);
+
+        if (0 != bytes % itemSize) {
+            succeeded = false;
+            break;
+        }
+
+        chunk.length = bytes / itemSize;
+
+        if (0 == chunk.length) {
+            break;
+        }
+
+        array_sort(&chunk, comp);
+
+        char* path;
+        FILE* run = create_run(config->tempDirectory, &path);
+
+        if (NULL == run) {
+            succeeded = false;
+            break;
+        }
+
+        run_list_push(runs, path);
+
+        succeeded = fwrite(chunk.data, itemSize, chunk.length, run) == (size_t)chunk.length;
+        succeeded = (0 == fclose(run)) && succeeded;
+    }
+
+    meta->deallocate(chunk.data);
+
+    return succeeded && !ferror(input);
+}
+
+static const void* reader_head(run_reader_t* reader, const size_t itemSize) {
+    if (reader->position == reader->count) {
+        reader->count = fread(reader->buffer, itemSize, reader->capacity, reader->file);
+        reader->position = 0;
+
+        if (0 == reader->count) {
+            return NULL;
+        }
+    }
+
+    return reader->buffer + (reader->position * itemSize);
+}
+
+static bool merge_runs(char** paths, const size_t runCount, FILE* output, const size_t itemSize, const comparator_t comp, const extsort_config_t* config) {
+    size_t share = config->memoryBudget / (runCount + 1);
+    size_t capacity = ((share < config->bufferSize) ? share : config->bufferSize) / itemSize;
+    run_reader_t* readers = (run_reader_t*)calloc(runCount > 0 ? runCount : 1, sizeof(run_reader_t));
+    const void** heads = (const void**)malloc((runCount > 0 ? runCount : 1) * sizeof(const void*));
+    bool succeeded = true;
+
+    if (0 == capacity) {
+        capacity = 1;
+    }
+
+    for (size_t index = 0; succeeded && index < runCount; ++index) {
+        run_reader_t* reader = readers + index;
+
+        reader->file = fopen(paths[index], "rb");
+        reader->buffer = (char*)malloc(capacity * itemSize);
+        reader->capacity = capacity;
+
+        if (NULL == reader->file) {
+            succeeded = false;
+        }
+        else {
+            heads[index] = reader_head(reader, itemSize);
+        }
+    }
+
+    if (succeeded) {
+        char* outBuffer = (char*)malloc(capacity * itemSize);
+        size_t outCount = 0;
+        loser_tree_t tree;
+        ptrdiff_t winner;
+
+        loser_tree_init(&tree, heads, runCount, comp);
+
+        while (succeeded && -1 != (winner = loser_tree_winner(&tree))) {
+            run_reader_t* reader = readers + winner;
+
+            memcpy(outBuffer + (outCount * itemSize), heads[winner], itemSize);
+            ++outCount;
+
+            if (outCount == capacity) {
+                succeeded = fwrite(outBuffer, itemSize, outCount, output) == outCount;
+                outCount = 0;
+            }
+
+            ++reader->position;
+            heads[winner] = reader_head(reader, itemSize);
+
+            loser_tree_replay(&tree);
+        }
+
+        if (succeeded && outCount > 0) {
+            succeeded = fwrite(outBuffer, itemSize, outCount, output) == outCount;
+        }
+
+        loser_tree_destroy(&tree);
+        free(outBuffer);
+    }
+
+    for (size_t index = 0; index < runCount; ++index) {
+        if (NULL != readers[index].file) {
+            succeeded = succeeded && !ferror(readers[index].file);
+
+            fclose(readers[index].file);
+        }
+
+        free(readers[index].buffer);
+    }
+
+    free(heads);
+    free(readers);
+
+    return succeeded;
+}
+
+static bool merge_pass(run_list_t* runs, const size_t fanIn, const size_t itemSize, const comparator_t comp, const extsort_config_t* config) {
+    run_list_t merged = { NULL, 0, 0 };
+    bool succeeded = true;
+
+    for (size_t start = 0; succeeded && start < runs->count; start += fanIn) {
+        size_t remaining = runs->count - start;
+        size_t group = (remaining < fanIn) ? remaining : fanIn;
+        char* path;
+        FILE* run = create_run(config->tempDirectory, &path);
+
+        if (NULL == run) {
+            succeeded = false;
+            break;
+        }
+
+        run_list_push(&merged, path);
+
+        succeeded = merge_runs(runs->paths + start, group, run, itemSize, comp, config);
+        succeeded = (0 == fclose(run)) && succeeded;
+    }
+
+    run_list_clear(runs);
+
+    if (succeeded) {
+        *runs = merged;
+    }
+    else {
+        run_list_clear(&merged);
+    }
+
+    return succeeded;
+}
+
+bool extsort_file(const char* inputPath, const char* outputPath, meta_t* meta, const comparator_t comp, const extsort_config_t* config) {
+    FILE* input = fopen(inputPath, "rb");
+
+    if (NULL == input) {
+        return false;
+    }
+
+    size_t fanIn = (config->maxFanIn < 2) ? 2 : config->maxFanIn;
+    run_list_t runs = { NULL, 0, 0 };
+    bool succeeded = create_runs(input, &runs, meta, comp, config);
+
+    fclose(input);
+
+    while (succeeded && runs.count > fanIn) {
+        succeeded = merge_pass(&runs, fanIn, meta->itemSize, comp, config);
+    }
+
+    if (succeeded) {
+        FILE* output = fopen(outputPath, "wb");
+
+        if (NULL == output) {
+            succeeded = false;
+        }
+        else {
+            succeeded = merge_runs(runs.paths, runs.count, output, meta->itemSize, comp, config);
+            succeeded = (0 == fclose(output)) && succeeded;
+        }
+    }
+
+    run_list_clear(&runs);
+
+    return succeeded;
+}
@@ -0,0 +1,21 @@
+#ifndef EXTSORT_H
+#define EXTSORT_H
+
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utils.h"
+
+typedef struct {
+    size_t memoryBudget;
+    size_t bufferSize;
+    size_t maxFanIn;
+    const char* tempDirectory;
+} extsort_config_t;
+
+void extsort_config_init(extsort_config_t*);
+
+bool extsort_file(const char*, const char*, meta_t*, const comparator_t, const extsort_config_t*);
+
+
+#endif
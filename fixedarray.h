@@ -0,0 +1,126 @@
+#ifndef FIXEDARRAY_H
+#define FIXEDARRAY_H
+
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "array.h"
+
+#define FIXED_ARRAY_NETWORK_MAX 16
+
+#define FIXED_ARRAY_UNROLL _Pragma("GCC unroll 16")
+
+#define FIXED_ARRAY_DECLARE(NAME, TYPE, N, LESS) \
+    typedef struct { \
+        TYPE data[N]; \
+    } NAME##_t; \
+    \
+    enum { NAME##_LENGTH = (N) }; \
+    \
+    static inline void NAME##_fill(NAME##_t* this, const TYPE value) { \
+        FIXED_ARRAY_UNROLL \
+        for (size_t index = 0; index < (N); ++index) { \
+            this->data[index] = value; \
+        } \
+    } \
+    \
+    static inline ptrdiff_t NAME##_find(const NAME##_t* this, const TYPE value) { \
+        FIXED_ARRAY_UNROLL \
+        for (size_t index = 0; index < (N); ++index) { \
+            if (!LESS(this->data[index], value) && !LESS(value, this->data[index])) { \
+                return index; \
+            } \
+        } \
+        \
+        return -1; \
+    } \
+    \
+    static inline size_t NAME##_count(const NAME##_t* this, const TYPE value) { \
+        size_t amount = 0; \
+        \
+        FIXED_ARRAY_UNROLL \
+        for (size_t index = 0; index < (N); ++index) { \
+            amount += !LESS(this->data[index], value) && !LESS(value, this->data[index]); \
+        } \
+        \
+        return amount; \
+    } \
+    \
+    static inline TYPE NAME##_minimum(const NAME##_t* this) { \
+        TYPE min = this->data[0]; \
+        \
+        FIXED_ARRAY_UNROLL \
+        for (size_t index = 1; index < (N); ++index) { \
+            min = LESS(this->data[index], min) ? this->data[index] : min; \
+        } \
+        \
+        return min; \
+    } \
+    \
+    static inline TYPE NAME##_maximum(const NAME##_t* this) { \
+        TYPE max = this->data[0]; \
+        \
+        FIXED_ARRAY_UNROLL \
+        for (size_t index = 1; index < (N); ++index) { \
+            max = LESS(max, this->data[index]) ? this->data[index] : max; \
+        } \
+        \
+        return max; \
+    } \
+    \
+    static inline void NAME##_compare_exchange(NAME##_t* this, const size_t low, const size_t high) { \
+        TYPE first = this->data[low]; \
+        TYPE second = this->data[high]; \
+        bool swapped = LESS(second, first); \
+        \
+        this->data[low] = swapped ? second : first; \
+        this->data[high] = swapped ? first : second; \
+    } \
+    \
+    static inline void NAME##_sort(NAME##_t* this) { \
+        if ((N) <= FIXED_ARRAY_NETWORK_MAX) { \
+            size_t top = 1; \
+            \
+            while (2 * top < (N)) { \
+                top *= 2; \
+            } \
+            \
+            FIXED_ARRAY_UNROLL \
+            for (size_t p = top; p > 0; p /= 2) { \
+                size_t r = 0; \
+                size_t d = p; \
+                \
+                for (size_t q = top; d > 0; q /= 2) { \
+                    FIXED_ARRAY_UNROLL \
+                    for (size_t index = 0; index + d < (N); ++index) { \
+                        if ((index & p) == r) { \
+                            NAME##_compare_exchange(this, index, index + d); \
+                        } \
+                    } \
+                    \
+                    d = q - p; \
+                    r = p; \
+                } \
+            } \
+        } \
+        else { \
+            for (size_t index = 1; index < (N); ++index) { \
+                TYPE value = this->data[index]; \
+                size_t hole = index; \
+                \
+                while (hole > 0 && LESS(value, this->data[hole - 1])) { \
+                    this->data[hole] = this->data[hole - 1]; \
+                    --hole; \
+                } \
+                \
+                this->data[hole] = value; \
+            } \
+        } \
+    } \
+    \
+    static inline array_t NAME##_view(NAME##_t* this, meta_t* meta) { \
+        return (array_t){ this->data, (N), meta }; \
+    }
+
+
+#endif
@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include "losertree.h"
+
+static bool beats(const loser_tree_t* this, const size_t left, const size_t right) {
+    const void* leftHead = this->heads[left];
+    const void* rightHead = this->heads[right];
+
+    if (NULL == leftHead) {
+        return false;
+    }
+    else if (NULL == rightHead) {
+        return true;
+    }
+
+    ptrdiff_t comparison = this->comp(leftHead, rightHead);
+
+    return comparison < 0 || (0 == comparison && left < right);
+}
+
+static size_t build(loser_tree_t* this, const size_t node) {
+    if (node >= this->count) {
+        return node - this->count;
+    }
+
+    size_t left = build(this, 2 * node);
+    size_t right = build(this, 2 * node + 1);
+
+    if (beats(this, left, right)) {
+        this->nodes[node] = right;
+
+        return left;
+    }
+    else {
+        this->nodes[node] = left;
+
+        return right;
+    }
+}
+
+void loser_tree_init(loser_tree_t* this, const void** heads, const size_t count, const comparator_t comp) {
+    this->nodes = (size_t*)malloc((count + 1) * sizeof(size_t));
+    this->heads = heads;
+    this->count = count;
+    this->comp = comp;
+
+    this->nodes[0] = (count > 1) ? build(this, 1) : 0;
+}
+
+void loser_tree_destroy(loser_tree_t* this) {
+    free(this->nodes);
+
+    this->nodes = NULL;
+    this->heads = NULL;
+    this->count = 0;
+}
+
+ptrdiff_t loser_tree_winner(const loser_tree_t* this) {
+    if (0 == this->count) {
+        return -1;
+    }
+
+    size_t winner = this->nodes[0];
+
+    return (NULL == this->heads[winner]) ? -1 : (ptrdiff_t)winner;
+}
+
+void loser_tree_replay(loser_tree_t* this) {
+    size_t winner = this->nodes[0];
+    size_t node = (winner + this->count) / 2;
+
+    while (node >= 1) {
+        if (beats(this, this->nodes[node], winner)) {
+            size_t temp = this->nodes[node];
+            this->nodes[node] = winner;
+            winner = temp;
+        }
+
+        node /= 2;
+    }
+
+    this->nodes[0] = winner;
+}
@@ -0,0 +1,24 @@
+#ifndef LOSERTREE_H
+#define LOSERTREE_H
+
+
+#include <stddef.h>
+#include "utils.h"
+
+typedef struct {
+    size_t* nodes;
+    const void** heads;
+    size_t count;
+    comparator_t comp;
+} loser_tree_t;
+
+void loser_tree_init(loser_tree_t*, const void**, const size_t, const comparator_t);
+
+void loser_tree_destroy(loser_tree_t*);
+
+ptrdiff_t loser_tree_winner(const loser_tree_t*);
+
+void loser_tree_replay(loser_tree_t*);
+
+
+#endif
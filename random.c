@@ -0,0 +1,95 @@
+#include "random.h"
+
+static uint64_t rotate_left(const uint64_t value, const int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static uint64_t splitmix64(uint64_t* seed) {
+    uint64_t value = (*seed += 0x9E3779B97F4A7C15ULL);
+
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+    return value ^ (value >> 31);
+}
+
+void rng_seed(rng_t* this, const uint64_t seed) {
+    uint64_t current = seed;
+
+    for (size_t index = 0; index < 4; ++index) {
+        this->state[index] = splitmix64(&current);
+    }
+}
+
+uint64_t rng_next(rng_t* this) {
+    uint64_t* s = this->state;
+    uint64_t result = rotate_left(s[1] * 5, 7) * 9;
+    uint64_t temp = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= temp;
+    s[3] = rotate_left(s[3], 45);
+
+    return result;
+}
+
+uint64_t rng_bounded(rng_t* this, const uint64_t bound) {
+    if (0 == bound) {
+        return 0;
+    }
+
+    unsigned __int128 product = (unsigned __int128)rng_next(this) * bound;
+    uint64_t low = (uint64_t)product;
+
+    if (low < bound) {
+        uint64_t threshold = -bound % bound;
+
+        while (low < threshold) {
+            product = (unsigned __int128)rng_next(this) * bound;
+            low = (uint64_t)product;
+        }
+    }
+
+    return (uint64_t)(product >> 64);
+}
+
+double rng_uniform(rng_t* this) {
+    return (rng_next(this) >> 11) * 0x1.0p-53;
+}
+
+void rng_jump(rng_t* this) {
+    static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+    uint64_t s0 = 0;
+    uint64_t s1 = 0;
+    uint64_t s2 = 0;
+    uint64_t s3 = 0;
+
+    for (size_t index = 0; index < 4; ++index) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (JUMP[index] & ((uint64_t)1 << bit)) {
+                s0 ^= this->state[0];
+                s1 ^= this->state[1];
+                s2 ^= this->state[2];
+                s3 ^= this->state[3];
+            }
+
+            rng_next(this);
+        }
+    }
+
+    this->state[0] = s0;
+    this->state[1] = s1;
+    this->state[2] = s2;
+    this->state[3] = s3;
+}
+
+void rng_split(rng_t* this, rng_t* stream) {
+    *stream = *this;
+
+    rng_jump(this);
+}
@@ -0,0 +1,25 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint64_t state[4];
+} rng_t;
+
+void rng_seed(rng_t*, const uint64_t);
+
+uint64_t rng_next(rng_t*);
+
+uint64_t rng_bounded(rng_t*, const uint64_t);
+
+double rng_uniform(rng_t*);
+
+void rng_jump(rng_t*);
+
+void rng_split(rng_t*, rng_t*);
+
+
+#endif
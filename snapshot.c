@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include "snapshot.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/membarrier.h>
+#endif
+
+#define QUIESCENT 0
+
+static bool register_heavy_barrier(void) {
+#ifdef __linux__
+    return 0 == syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0);
+#else
+    return false;
+#endif
+}
+
+static void heavy_barrier(const snapshot_t* this) {
+#ifdef __linux__
+    if (this->asymmetric && 0 == syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0)) {
+        return;
+    }
+#endif
+
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+static array_t* take_version(array_t* array) {
+    array_t* version = (array_t*)malloc(sizeof(array_t));
+
+    array_move(version, array);
+
+    return version;
+}
+
+static void destroy_version(array_t* version) {
+    array_destroy(version);
+
+    free(version);
+}
+
+void snapshot_init(snapshot_t* this, array_t* initial, const size_t readerCount) {
+    atomic_init(&this->current, take_version(initial));
+    atomic_init(&this->epoch, 1);
+
+    this->readers = (snapshot_reader_t*)calloc(readerCount, sizeof(snapshot_reader_t));
+    this->readerCount = readerCount;
+    this->retired = NULL;
+
+    for (size_t index = 0; index < readerCount; ++index) {
+        atomic_init(&this->readers[index].epoch, QUIESCENT);
+        atomic_init(&this->readers[index].claimed, false);
+    }
+
+    pthread_mutex_init(&this->writeLock, NULL);
+
+    this->asymmetric = register_heavy_barrier();
+}
+
+void snapshot_destroy(snapshot_t* this) {
+    retired_version_t* node = this->retired;
+
+    while (NULL != node) {
+        retired_version_t* next = node->next;
+
+        destroy_version(node->version);
+        free(node);
+
+        node = next;
+    }
+
+    destroy_version(atomic_load(&this->current));
+    free(this->readers);
+    pthread_mutex_destroy(&this->writeLock);
+
+    this->retired = NULL;
+    this->readers = NULL;
+    this->readerCount = 0;
+}
+
+snapshot_reader_t* snapshot_register(snapshot_t* this) {
+    for (size_t index = 0; index < this->readerCount; ++index) {
+        snapshot_reader_t* reader = this->readers + index;
+        bool expected = false;
+
+        if (atomic_compare_exchange_strong(&reader->claimed, &expected, true)) {
+            return reader;
+        }
+    }
+
+    return NULL;
+}
+
+void snapshot_unregister(snapshot_reader_t* reader) {
+    atomic_store_explicit(&reader->epoch, QUIESCENT, memory_order_release);
+    atomic_store_explicit(&reader->claimed, false, memory_order_release);
+}
+
+const array_t* snapshot_enter(snapshot_t* this, snapshot_reader_t* reader) {
+    uint64_t epoch = atomic_load_explicit(&this->epoch, memory_order_acquire);
+
+    if (this->asymmetric) {
+        atomic_store_explicit(&reader->epoch, epoch, memory_order_relaxed);
+        atomic_signal_fence(memory_order_seq_cst);
+    }
+    else {
+        atomic_store_explicit(&reader->epoch, epoch, memory_order_seq_cst);
+    }
+
+    return atomic_load_explicit(&this->current, memory_order_acquire);
+}
+
+void snapshot_leave(snapshot_reader_t* reader) {
+    atomic_store_explicit(&reader->epoch, QUIESCENT, memory_order_release);
+}
+
+static uint64_t oldest_active_epoch(const snapshot_t* this) {
+    uint64_t oldest = UINT64_MAX;
+
+    for (size_t index = 0; index < this->readerCount; ++index) {
+        uint64_t epoch = atomic_load_explicit(&this->readers[index].epoch, memory_order_seq_cst);
+
+        if (QUIESCENT != epoch && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    return oldest;
+}
+
+static size_t reclaim_locked(snapshot_t* this) {
+    heavy_barrier(this);
+
+    uint64_t oldest = oldest_active_epoch(this);
+    retired_version_t** link = &this->retired;
+    size_t amount = 0;
+
+    while (NULL != *link) {
+        retired_version_t* node = *link;
+
+        if (node->epoch < oldest) {
+            *link = node->next;
+
+            destroy_version(node->version);
+            free(node);
+
+            ++amount;
+        }
+        else {
+            link = &node->next;
+        }
+    }
+
+    return amount;
+}
+
+static void publish_locked(snapshot_t* this, array_t* version) {
+    array_t* old = atomic_exchange_explicit(&this->current, version, memory_order_seq_cst);
+    retired_version_t* node = (retired_version_t*)malloc(sizeof(retired_version_t));
+
+    node->version = old;
+    node->epoch = atomic_fetch_add_explicit(&this->epoch, 1, memory_order_seq_cst);
+    node->next = this->retired;
+    this->retired = node;
+
+    reclaim_locked(this);
+}
+
+void snapshot_publish(snapshot_t* this, array_t* array) {
+    array_t* version = take_version(array);
+
+    pthread_mutex_lock(&this->writeLock);
+    publish_locked(this, version);
+    pthread_mutex_unlock(&this->writeLock);
+}
+
+static array_t* clone_current(snapshot_t* this) {
+    const array_t* current = atomic_load_explicit(&this->current, memory_order_acquire);
+    array_t* version = (array_t*)malloc(sizeof(array_t));
+
+    version->data = NULL;
+    version->length = 0;
+    version->meta = current->meta;
+
+    array_copy(version, current);
+
+    return version;
+}
+
+void snapshot_update(snapshot_t* this, const updater_t update, void* context) {
+    pthread_mutex_lock(&this->writeLock);
+
+    array_t* version = clone_current(this);
+
+    update(version, context);
+    publish_locked(this, version);
+
+    pthread_mutex_unlock(&this->writeLock);
+}
+
+void snapshot_set_batch(snapshot_t* this, const size_t* indices, const void* values, const size_t count) {
+    pthread_mutex_lock(&this->writeLock);
+
+    array_t* version = clone_current(this);
+    size_t itemSize = version->meta->itemSize;
+    const char* value = (const char*)values;
+
+    for (size_t index = 0; index < count; ++index) {
+        array_set_copy(version, indices[index], value);
+
+        value += itemSize;
+    }
+
+    publish_locked(this, version);
+
+    pthread_mutex_unlock(&this->writeLock);
+}
+
+size_t snapshot_reclaim(snapshot_t* this) {
+    pthread_mutex_lock(&this->writeLock);
+
+    size_t amount = reclaim_locked(this);
+
+    pthread_mutex_unlock(&this->writeLock);
+
+    return amount;
+}
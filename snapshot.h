@@ -0,0 +1,57 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "array.h"
+
+typedef void(*updater_t)(array_t*, void*);
+
+typedef struct {
+    _Atomic uint64_t epoch;
+    atomic_bool claimed;
+    char padding[64 - sizeof(uint64_t) - sizeof(bool)];
+} snapshot_reader_t;
+
+typedef struct retired_version {
+    array_t* version;
+    uint64_t epoch;
+    struct retired_version* next;
+} retired_version_t;
+
+typedef struct {
+    _Atomic(array_t*) current;
+    _Atomic uint64_t epoch;
+    snapshot_reader_t* readers;
+    size_t readerCount;
+    retired_version_t* retired;
+    pthread_mutex_t writeLock;
+    bool asymmetric;
+} snapshot_t;
+
+void snapshot_init(snapshot_t*, array_t*, const size_t);
+
+void snapshot_destroy(snapshot_t*);
+
+snapshot_reader_t* snapshot_register(snapshot_t*);
+
+void snapshot_unregister(snapshot_reader_t*);
+
+const array_t* snapshot_enter(snapshot_t*, snapshot_reader_t*);
+
+void snapshot_leave(snapshot_reader_t*);
+
+void snapshot_publish(snapshot_t*, array_t*);
+
+void snapshot_update(snapshot_t*, const updater_t, void*);
+
+void snapshot_set_batch(snapshot_t*, const size_t*, const void*, const size_t);
+
+size_t snapshot_reclaim(snapshot_t*);
+
+
+#endif
@@ -1,11 +1,892 @@
 #include <stdlib.h>
-#include <time.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "array.h"
+#include "extsort.h"
+#include "fixedarray.h"
+#include "snapshot.h"
 
-int main(void) {
-    time_t tm;
-    srand(time(&tm));
+static void int_copy(void* dest, const void* src) {
+    *(int*)dest = *(const int*)src;
+}
+
+static void int_move(void* dest, void* src) {
+    *(int*)dest = *(int*)src;
+}
+
+static bool int_equals(const void* left, const void* right) {
+    return *(const int*)left == *(const int*)right;
+}
+
+static ptrdiff_t int_compare(const void* left, const void* right) {
+    int leftValue = *(const int*)left;
+    int rightValue = *(const int*)right;
+
+    return (leftValue > rightValue) - (leftValue < rightValue);
+}
+
+static void double_copy(void* dest, const void* src) {
+    *(double*)dest = *(const double*)src;
+}
+
+static void double_move(void* dest, void* src) {
+    *(double*)dest = *(double*)src;
+}
+
+static bool double_equals(const void* left, const void* right) {
+    return *(const double*)left == *(const double*)right;
+}
+
+static void int_add(void* acc, const void* item) {
+    *(int*)acc += *(const int*)item;
+}
+
+static meta_t intMeta = { sizeof(int), "int", int_copy, int_move, int_equals, NULL, malloc, free };
+
+static meta_t doubleMeta = { sizeof(double), "double", double_copy, double_move, double_equals, NULL, malloc, free };
+
+static array_t make_int_array(const ptrdiff_t length) {
+    array_t array = { malloc((length > 0 ? length : 1) * sizeof(int)), length, &intMeta };
+
+    return array;
+}
+
+static void sort_test(void) {
+    rng_t rng;
+    rng_seed(&rng, 1);
+
+    for (ptrdiff_t length = 0; length <= 64; ++length) {
+        array_t array = make_int_array(length);
+        int* data = (int*)(array.data);
+
+        for (ptrdiff_t index = 0; index < length; ++index) {
+            data[index] = (int)rng_bounded(&rng, 10);
+        }
+
+        array_sort(&array, int_compare);
+        assert(array_sorted(&array, int_compare));
+
+        for (ptrdiff_t index = 0; index < length; ++index) {
+            data[index] = length - index;
+        }
+
+        array_sort(&array, int_compare);
+        assert(array_sorted(&array, int_compare));
+
+        array_destroy(&array);
+    }
+}
+
+static size_t moveCount = 0;
+
+static void counting_move(void* dest, void* src) {
+    *(int*)dest = *(int*)src;
+
+    ++moveCount;
+}
+
+static bool is_even(const void* item) {
+    return 0 == *(const int*)item % 2;
+}
+
+static void bitset_test(void) {
+    size_t lengths[] = { 0, 1, 63, 64, 65, 130 };
+
+    for (size_t test = 0; test < sizeof(lengths) / sizeof(lengths[0]); ++test) {
+        size_t length = lengths[test];
+        bitset_t bits;
+        bitset_t other;
+
+        bitset_init(&bits, length);
+        assert(bitset_none(&bits));
+        assert(-1 == bitset_find_next(&bits, 0));
+
+        bitset_flip(&bits);
+        assert(length == bitset_count(&bits));
+        assert(bitset_all(&bits));
+        assert(-1 == bitset_find_next(&bits, length));
+
+        if (length > 0) {
+            assert((ptrdiff_t)(length - 1) == bitset_find_next(&bits, length - 1));
+        }
+
+        bitset_flip(&bits);
+        assert(0 == bitset_count(&bits));
+
+        if (length > 64) {
+            bitset_set(&bits, 64, true);
+            assert(64 == bitset_find_next(&bits, 0));
+            assert(-1 == bitset_find_next(&bits, 65));
+        }
+
+        other.words = NULL;
+        other.length = 0;
+        bitset_copy(&other, &bits);
+        bitset_flip(&other);
+        bitset_or(&other, &bits);
+        assert(bitset_all(&other));
+        bitset_and(&other, &bits);
+        assert(bitset_count(&other) == bitset_count(&bits));
+
+        bitset_destroy(&other);
+        bitset_destroy(&bits);
+    }
+}
+
+static void mask_test(void) {
+    meta_t countingMeta = intMeta;
+    countingMeta.move = counting_move;
+
+    array_t array = { malloc(130 * sizeof(int)), 130, &countingMeta };
+    int* data = (int*)(array.data);
+
+    for (int index = 0; index < 130; ++index) {
+        data[index] = index;
+    }
+
+    bitset_t mask = array_eval_mask(&array, is_even);
+    assert(65 == bitset_count(&mask));
+    assert(bitset_get(&mask, 128) && !bitset_get(&mask, 129));
+
+    array_t selected;
+    array_select(&selected, &array, &mask);
+    assert(65 == selected.length);
+    assert(128 == ((int*)(selected.data))[64]);
+
+    int replacement = -1;
+    bitset_flip(&mask);
+    array_replace_masked(&array, &replacement, &mask);
+    assert(65 == array_count(&array, &replacement));
+    assert(0 == data[0] && -1 == data[129]);
+
+    moveCount = 0;
+    assert(65 == array_compress(&array, &mask));
+    assert(65 == array.length && 65 == array_count(&array, &replacement));
+    assert(65 == moveCount);
+
+    bitset_destroy(&mask);
+    array_destroy(&selected);
+    array_destroy(&array);
+}
+
+static void reduction_test(void) {
+    ptrdiff_t length = 200003;
+    array_t array = make_int_array(length);
+    array_t doubles = { malloc(length * sizeof(double)), length, &doubleMeta };
+    int* data = (int*)(array.data);
+    double* doubleData = (double*)(doubles.data);
+    long long expectedSum = 0;
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        data[index] = (int)((index * 7919) % 2001) - 1000;
+        doubleData[index] = data[index] * 0.5;
+        expectedSum += data[index];
+    }
+
+    int intResult = 0;
+    double doubleResult = 0.0;
+
+    assert(expectedSum == array_sum_int(&array));
+    assert(expectedSum == array_sum_int_parallel(&array, 4));
+    assert(expectedSum * 0.5 == array_sum_double_parallel(&doubles, 3));
+    assert(array_min_int(&array, &intResult) && -1000 == intResult);
+    assert(array_max_int_parallel(&array, &intResult, 4) && 1000 == intResult);
+    assert(array_min_double_parallel(&doubles, &doubleResult, 5) && -500.0 == doubleResult);
+    assert(array_max_double(&doubles, &doubleResult) && 500.0 == doubleResult);
+
+    minmax_t extremes = array_minmax(&array, int_compare);
+    assert(-1000 == *(const int*)extremes.min && 1000 == *(const int*)extremes.max);
+
+    int zero = 0;
+    int total = 0;
+    array_reduce_parallel(&array, &total, &zero, int_add, 4);
+    assert(expectedSum == total);
+
+    array_t scanned = make_int_array(0);
+    array_copy(&scanned, &array);
+    array_inclusive_scan(&scanned, int_add);
+    array_inclusive_scan_parallel(&array, &zero, int_add, 4);
+    assert(array_equals(&array, &scanned));
+    assert(expectedSum == ((int*)(array.data))[length - 1]);
+
+    array_exclusive_scan(&scanned, &zero, int_add);
+    array_exclusive_scan_parallel(&array, &zero, int_add, 3);
+    assert(array_equals(&array, &scanned));
+
+    array_destroy(&scanned);
+    array_destroy(&doubles);
+    array_destroy(&array);
+
+    array = make_int_array(5);
+    data = (int*)(array.data);
+
+    for (int index = 0; index < 5; ++index) {
+        data[index] = index + 1;
+    }
+
+    assert(120 == array_product_int(&array));
+    array_exclusive_scan(&array, &zero, int_add);
+    assert(0 == data[0] && 10 == data[4]);
+
+    array.length = 0;
+    assert(0 == array_sum_int(&array) && 1 == array_product_int(&array));
+    assert(!array_min_int(&array, &intResult) && !array_max_int(&array, &intResult));
+
+    extremes = array_minmax(&array, int_compare);
+    assert(NULL == extremes.min && NULL == extremes.max);
+
+    array_destroy(&array);
+}
+
+static size_t batchCalls = 0;
+
+static void batch_is_large(const void* items, const size_t count, const size_t stride, bool* results) {
+    const char* ptr = (const char*)items;
+
+    for (size_t index = 0; index < count; ++index) {
+        results[index] = *(const int*)ptr >= 2500;
+
+        ptr += stride;
+    }
+
+    ++batchCalls;
+}
+
+static void batch_increment(void* items, const size_t count, const size_t stride) {
+    char* ptr = (char*)items;
+
+    for (size_t index = 0; index < count; ++index) {
+        ++*(int*)ptr;
+
+        ptr += stride;
+    }
+}
+
+static void product_overflow_test(void) {
+    ptrdiff_t length = 100000;
+    array_t array = make_int_array(length);
+    int* data = (int*)(array.data);
+    unsigned long long expected = 1;
+
+    for (ptrdiff_t index = 0; index < 40; ++index) {
+        data[index] = 10;
+        expected *= 10;
+    }
+
+    array.length = 40;
+    assert((long long)expected == array_product_int(&array));
+
+    expected = 1;
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        data[index] = (0 == index % 7) ? -3 : 3;
+        expected *= (unsigned long long)data[index];
+    }
+
+    array.length = length;
+    assert((long long)expected == array_product_int(&array));
+    assert((long long)expected == array_product_int_parallel(&array, 4));
+
+    array_destroy(&array);
+}
+
+static void batch_test(void) {
+    array_t array = make_int_array(3000);
+    int* data = (int*)(array.data);
+
+    for (int index = 0; index < 3000; ++index) {
+        data[index] = index;
+    }
+
+    batchCalls = 0;
+    assert(500 == array_count_if_batch(&array, batch_is_large));
+    assert(3 == batchCalls);
+
+    assert(2500 == array_find_if_batch(&array, 0, batch_is_large));
+    assert(2999 == array_find_if_batch(&array, 2999, batch_is_large));
+
+    array_for_each_batch(&array, batch_increment);
+    assert(1 == data[0] && 3000 == data[2999]);
+    assert(2499 == array_find_if_batch(&array, 0, batch_is_large));
+
+    int zero = 0;
+    array_replace_if_batch(&array, &zero, batch_is_large);
+    assert(0 == array_count_if_batch(&array, batch_is_large));
+    assert(501 == array_count(&array, &zero) && 2499 == data[2498]);
+
+    array.length = 0;
+    assert(-1 == array_find_if_batch(&array, 0, batch_is_large));
+
+    array_destroy(&array);
+}
+
+static void random_test(void) {
+    rng_t first;
+    rng_t second;
+    rng_t stream;
+
+    rng_seed(&first, 42);
+    rng_seed(&second, 42);
+
+    for (int index = 0; index < 100; ++index) {
+        assert(rng_next(&first) == rng_next(&second));
+    }
+
+    rng_split(&first, &stream);
+    assert(rng_next(&stream) == rng_next(&second));
+    assert(rng_next(&first) != rng_next(&second));
+
+    assert(0 == rng_bounded(&first, 0));
+    assert(0 == rng_bounded(&first, 1));
+
+    for (int index = 0; index < 1000; ++index) {
+        assert(rng_bounded(&first, 7) < 7);
+
+        double value = rng_uniform(&first);
+        assert(value >= 0.0 && value < 1.0);
+    }
+}
+
+static void shuffle_test(void) {
+    rng_t rng;
+    rng_seed(&rng, 7);
+
+    array_t array = make_int_array(3);
+    int* data = (int*)(array.data);
+    size_t counts[9] = { 0 };
+    int trials = 60000;
+
+    for (int trial = 0; trial < trials; ++trial) {
+        data[0] = 0;
+        data[1] = 1;
+        data[2] = 2;
+
+        array_shuffle(&array, &rng);
+
+        ++counts[data[0] * 3 + data[1]];
+    }
+
+    for (int first = 0; first < 3; ++first) {
+        for (int second = 0; second < 3; ++second) {
+            size_t count = counts[first * 3 + second];
+
+            if (first == second) {
+                assert(0 == count);
+            }
+            else {
+                assert(count > trials / 6 * 0.95 && count < trials / 6 * 1.05);
+            }
+        }
+    }
+
+    array_destroy(&array);
+
+    ptrdiff_t length = 200000;
+    array = make_int_array(length);
+    data = (int*)(array.data);
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        data[index] = index;
+    }
+
+    array_shuffle_parallel(&array, &rng, 4);
+    assert(!array_sorted(&array, int_compare));
+
+    array_sort(&array, int_compare);
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        assert(index == data[index]);
+    }
+
+    array_destroy(&array);
+}
+
+static void check_sample(const array_t* sample, const size_t expected, size_t* hits) {
+    assert((ptrdiff_t)expected == sample->length);
+
+    for (ptrdiff_t index = 0; index < sample->length; ++index) {
+        int value = *(const int*)array_get_const(sample, index);
+
+        if (index > 0) {
+            assert(value > *(const int*)array_get_const(sample, index - 1));
+        }
+
+        ++hits[value];
+    }
+}
+
+static void sample_test(void) {
+    rng_t rng;
+    rng_seed(&rng, 11);
+
+    array_t array = make_int_array(10);
+    int* data = (int*)(array.data);
+    size_t floydHits[10] = { 0 };
+    size_t reservoirHits[10] = { 0 };
+    int trials = 30000;
 
-    //array_test();
+    for (int index = 0; index < 10; ++index) {
+        data[index] = index;
+    }
+
+    for (int trial = 0; trial < trials; ++trial) {
+        array_t sample;
+
+        array_sample(&sample, &array, 3, &rng);
+        check_sample(&sample, 3, floydHits);
+        array_destroy(&sample);
+
+        array_sample_reservoir(&sample, &array, 3, &rng);
+        check_sample(&sample, 3, reservoirHits);
+        array_destroy(&sample);
+    }
+
+    for (int index = 0; index < 10; ++index) {
+        assert(floydHits[index] > trials * 0.3 * 0.95 && floydHits[index] < trials * 0.3 * 1.05);
+        assert(reservoirHits[index] > trials * 0.3 * 0.95 && reservoirHits[index] < trials * 0.3 * 1.05);
+    }
+
+    size_t hits[10] = { 0 };
+    array_t sample;
+
+    array_sample(&sample, &array, 25, &rng);
+    check_sample(&sample, 10, hits);
+    array_destroy(&sample);
+
+    array_sample(&sample, &array, 0, &rng);
+    check_sample(&sample, 0, hits);
+    array_destroy(&sample);
+
+    array_destroy(&array);
+}
+
+typedef struct {
+    int key;
+    int tag;
+    char payload[248];
+} record_t;
+
+static void record_copy(void* dest, const void* src) {
+    *(record_t*)dest = *(const record_t*)src;
+}
+
+static void record_move(void* dest, void* src) {
+    *(record_t*)dest = *(record_t*)src;
+}
+
+static bool record_equals(const void* left, const void* right) {
+    return ((const record_t*)left)->key == ((const record_t*)right)->key;
+}
+
+static ptrdiff_t record_compare(const void* left, const void* right) {
+    return int_compare(&((const record_t*)left)->key, &((const record_t*)right)->key);
+}
+
+static void record_key(void* key, const void* record) {
+    *(int*)key = ((const record_t*)record)->key;
+}
+
+static meta_t recordMeta = { sizeof(record_t), "record", record_copy, record_move, record_equals, NULL, malloc, free };
+
+static void permutation_test(void) {
+    size_t permutation[] = { 0, 2, 3, 1, 5, 4, 6, 9, 7, 8 };
+    array_t first = make_int_array(10);
+    array_t second = make_int_array(10);
+
+    for (int index = 0; index < 10; ++index) {
+        ((int*)(first.data))[index] = index * 10;
+        ((int*)(second.data))[index] = -index;
+    }
+
+    array_apply_permutation(&first, permutation);
+    array_apply_permutation(&second, permutation);
+
+    for (int index = 0; index < 10; ++index) {
+        assert((int)permutation[index] * 10 == ((int*)(first.data))[index]);
+        assert(-(int)permutation[index] == ((int*)(second.data))[index]);
+    }
+
+    array_destroy(&first);
+    array_destroy(&second);
+
+    ptrdiff_t length = 2000;
+    array_t records = { malloc(length * sizeof(record_t)), length, &recordMeta };
+    record_t* data = (record_t*)(records.data);
+    size_t* order = (size_t*)malloc(length * sizeof(size_t));
+    rng_t rng;
+
+    rng_seed(&rng, 13);
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        data[index].key = (int)rng_bounded(&rng, 50);
+        data[index].tag = index;
+        data[index].payload[0] = (char)index;
+    }
+
+    array_argsort(&records, order, record_compare);
+
+    for (ptrdiff_t index = 1; index < length; ++index) {
+        const record_t* previous = data + order[index - 1];
+        const record_t* current = data + order[index];
+
+        assert(previous->key < current->key || (previous->key == current->key && previous->tag < current->tag));
+    }
+
+    array_sort_by_key(&records, sizeof(int), record_key, int_compare);
+
+    for (ptrdiff_t index = 0; index < length; ++index) {
+        assert((ptrdiff_t)order[index] == data[index].tag);
+        assert((char)data[index].tag == data[index].payload[0]);
+    }
+
+    free(order);
+    array_destroy(&records);
+}
+
+static void merge_test(void) {
+    array_t inputs[4];
+    const array_t* pointers[4];
+
+    for (int source = 0; source < 4; ++source) {
+        ptrdiff_t length = 10 + source;
+
+        inputs[source].data = malloc(length * sizeof(record_t));
+        inputs[source].length = length;
+        inputs[source].meta = &recordMeta;
+        pointers[source] = inputs + source;
+
+        for (ptrdiff_t index = 0; index < length; ++index) {
+            record_t* record = (record_t*)array_get(inputs + source, index);
+
+            record->key = index / 3;
+            record->tag = source * 1000 + index;
+        }
+    }
+
+    array_t merged;
+    assert(array_merge_k(&merged, pointers, 4, record_compare));
+    assert(46 == merged.length);
+
+    for (ptrdiff_t index = 1; index < merged.length; ++index) {
+        const record_t* previous = (const record_t*)array_get_const(&merged, index - 1);
+        const record_t* current = (const record_t*)array_get_const(&merged, index);
+
+        assert(previous->key < current->key || (previous->key == current->key && previous->tag < current->tag));
+    }
+
+    array_destroy(&merged);
+
+    array_t ints = make_int_array(3);
+    const array_t* mixed[] = { pointers[0], &ints };
+
+    assert(!array_merge_k(&merged, pointers, 0, record_compare));
+    assert(!array_merge_k(&merged, mixed, 2, record_compare));
+
+    array_destroy(&ints);
+
+    for (int source = 0; source < 4; ++source) {
+        array_destroy(inputs + source);
+    }
+}
+
+static void check_extsort(const char* inputPath, const char* outputPath, const extsort_config_t* config, const int count, const long long sum) {
+    assert(extsort_file(inputPath, outputPath, &intMeta, int_compare, config));
+
+    FILE* output = fopen(outputPath, "rb");
+    int previous = -1;
+    int value;
+    int amount = 0;
+    long long total = 0;
+
+    while (1 == fread(&value, sizeof(int), 1, output)) {
+        assert(value >= previous);
+
+        previous = value;
+        total += value;
+        ++amount;
+    }
+
+    fclose(output);
+
+    assert(count == amount && sum == total);
+}
+
+static void extsort_test(void) {
+    const char* inputPath = "/tmp/collections_extsort_input.bin";
+    const char* outputPath = "/tmp/collections_extsort_output.bin";
+    int count = 100000;
+    long long sum = 0;
+    rng_t rng;
+
+    rng_seed(&rng, 3);
+
+    FILE* input = fopen(inputPath, "wb");
+    assert(NULL != input);
+
+    for (int index = 0; index < count; ++index) {
+        int value = (int)rng_bounded(&rng, 1000000);
+
+        fwrite(&value, sizeof(int), 1, input);
+        sum += value;
+    }
+
+    fclose(input);
+
+    extsort_config_t config;
+    extsort_config_init(&config);
+
+    check_extsort(inputPath, outputPath, &config, count, sum);
+
+    config.memoryBudget = 4000;
+    config.bufferSize = 512;
+    config.maxFanIn = 4;
+    check_extsort(inputPath, outputPath, &config, count, sum);
+
+    struct rlimit original;
+    struct rlimit limited;
+
+    getrlimit(RLIMIT_NOFILE, &original);
+    limited = original;
+    limited.rlim_cur = 32;
+    setrlimit(RLIMIT_NOFILE, &limited);
+
+    extsort_config_init(&config);
+    config.memoryBudget = 4000;
+    check_extsort(inputPath, outputPath, &config, count, sum);
+
+    setrlimit(RLIMIT_NOFILE, &original);
+
+    int values[] = { 3, 1, 2 };
+    unsigned char trailing[2] = { 0, 0 };
+
+    input = fopen(inputPath, "wb");
+    fwrite(values, sizeof(int), 3, input);
+    fwrite(trailing, 1, sizeof(trailing), input);
+    fclose(input);
+
+    extsort_config_init(&config);
+    assert(!extsort_file(inputPath, outputPath, &intMeta, int_compare, &config));
+
+    config.memoryBudget = 8;
+    assert(!extsort_file(inputPath, outputPath, &intMeta, int_compare, &config));
+
+    remove(inputPath);
+    remove(outputPath);
+}
+
+#define INT_LESS(left, right) ((left) < (right))
+
+FIXED_ARRAY_DECLARE(fixed1, int, 1, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed2, int, 2, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed3, int, 3, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed4, int, 4, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed5, int, 5, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed6, int, 6, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed7, int, 7, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed8, int, 8, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed9, int, 9, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed10, int, 10, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed11, int, 11, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed12, int, 12, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed13, int, 13, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed14, int, 14, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed15, int, 15, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed16, int, 16, INT_LESS)
+FIXED_ARRAY_DECLARE(fixed20, int, 20, INT_LESS)
+
+#define CHECK_ZERO_ONE(NAME) \
+    for (unsigned bits = 0; bits < (1u << NAME##_LENGTH); ++bits) { \
+        NAME##_t fixed; \
+        \
+        for (size_t index = 0; index < NAME##_LENGTH; ++index) { \
+            fixed.data[index] = (bits >> index) & 1; \
+        } \
+        \
+        NAME##_sort(&fixed); \
+        \
+        array_t view = NAME##_view(&fixed, &intMeta); \
+        assert(array_sorted(&view, int_compare)); \
+        assert((size_t)__builtin_popcount(bits) == NAME##_count(&fixed, 1)); \
+    }
+
+static void fixed_array_test(void) {
+    CHECK_ZERO_ONE(fixed1);
+    CHECK_ZERO_ONE(fixed2);
+    CHECK_ZERO_ONE(fixed3);
+    CHECK_ZERO_ONE(fixed4);
+    CHECK_ZERO_ONE(fixed5);
+    CHECK_ZERO_ONE(fixed6);
+    CHECK_ZERO_ONE(fixed7);
+    CHECK_ZERO_ONE(fixed8);
+    CHECK_ZERO_ONE(fixed9);
+    CHECK_ZERO_ONE(fixed10);
+    CHECK_ZERO_ONE(fixed11);
+    CHECK_ZERO_ONE(fixed12);
+    CHECK_ZERO_ONE(fixed13);
+    CHECK_ZERO_ONE(fixed14);
+    CHECK_ZERO_ONE(fixed15);
+    CHECK_ZERO_ONE(fixed16);
+
+    fixed20_t large;
+    rng_t rng;
+
+    rng_seed(&rng, 17);
+
+    for (int trial = 0; trial < 1000; ++trial) {
+        for (size_t index = 0; index < fixed20_LENGTH; ++index) {
+            large.data[index] = (int)rng_bounded(&rng, 100);
+        }
+
+        fixed20_sort(&large);
+
+        array_t view = fixed20_view(&large, &intMeta);
+        assert(array_sorted(&view, int_compare));
+    }
+
+    fixed8_t small;
+    fixed8_fill(&small, 3);
+    small.data[5] = 1;
+    small.data[6] = 9;
+
+    assert(5 == fixed8_find(&small, 1));
+    assert(-1 == fixed8_find(&small, 4));
+    assert(6 == fixed8_count(&small, 3));
+    assert(1 == fixed8_minimum(&small));
+    assert(9 == fixed8_maximum(&small));
+
+    array_t view = fixed8_view(&small, &intMeta);
+    assert(8 == view.length && 6 == array_find(&view, 0, &small.data[6]));
+}
+
+static void array_test(void) {
+    sort_test();
+    bitset_test();
+    mask_test();
+    reduction_test();
+    product_overflow_test();
+    batch_test();
+    random_test();
+    shuffle_test();
+    sample_test();
+    permutation_test();
+    merge_test();
+    extsort_test();
+    fixed_array_test();
+}
+
+#define SNAPSHOT_LENGTH 64
+#define SNAPSHOT_READERS 4
+#define SNAPSHOT_WRITES 3000
+
+static size_t destroyCount = 0;
+static atomic_bool readersStop;
+
+static void counting_destroy(void* item) {
+    (void)item;
+
+    ++destroyCount;
+}
+
+static meta_t snapshotMeta = { sizeof(int), "int", int_copy, int_move, int_equals, counting_destroy, malloc, free };
+
+static array_t make_version(const int value) {
+    array_t array = { malloc(SNAPSHOT_LENGTH * sizeof(int)), SNAPSHOT_LENGTH, &snapshotMeta };
+
+    array_fill(&array, &value);
+
+    return array;
+}
+
+static void fill_version(array_t* array, void* context) {
+    array_fill(array, context);
+}
+
+static void* snapshot_reader(void* arg) {
+    snapshot_t* snapshot = (snapshot_t*)arg;
+    int lastSeen = 0;
+
+    while (!atomic_load(&readersStop)) {
+        snapshot_reader_t* reader = snapshot_register(snapshot);
+
+        assert(NULL != reader);
+
+        for (int lookup = 0; lookup < 1000; ++lookup) {
+            const array_t* version = snapshot_enter(snapshot, reader);
+            int value = *(const int*)array_get_const(version, 0);
+
+            assert(SNAPSHOT_LENGTH == version->length);
+            assert(SNAPSHOT_LENGTH == array_count(version, &value));
+            assert(value >= lastSeen);
+
+            lastSeen = value;
+
+            snapshot_leave(reader);
+        }
+
+        snapshot_unregister(reader);
+    }
+
+    return NULL;
+}
+
+static void snapshot_test(void) {
+    snapshot_t snapshot;
+    array_t initial = make_version(0);
+    pthread_t readers[SNAPSHOT_READERS];
+    size_t indices[SNAPSHOT_LENGTH];
+
+    for (size_t index = 0; index < SNAPSHOT_LENGTH; ++index) {
+        indices[index] = index;
+    }
+
+    destroyCount = 0;
+    atomic_store(&readersStop, false);
+    snapshot_init(&snapshot, &initial, SNAPSHOT_READERS * 2);
+
+    for (size_t index = 0; index < SNAPSHOT_READERS; ++index) {
+        assert(0 == pthread_create(readers + index, NULL, snapshot_reader, &snapshot));
+    }
+
+    for (int value = 1; value <= SNAPSHOT_WRITES; ++value) {
+        if (0 == value % 3) {
+            array_t version = make_version(value);
+
+            snapshot_publish(&snapshot, &version);
+        }
+        else if (1 == value % 3) {
+            snapshot_update(&snapshot, fill_version, &value);
+        }
+        else {
+            int values[SNAPSHOT_LENGTH];
+
+            for (size_t index = 0; index < SNAPSHOT_LENGTH; ++index) {
+                values[index] = value;
+            }
+
+            snapshot_set_batch(&snapshot, indices, values, SNAPSHOT_LENGTH);
+        }
+    }
+
+    atomic_store(&readersStop, true);
+
+    for (size_t index = 0; index < SNAPSHOT_READERS; ++index) {
+        pthread_join(readers[index], NULL);
+    }
+
+    snapshot_reclaim(&snapshot);
+    assert(NULL == snapshot.retired);
+    assert((size_t)SNAPSHOT_WRITES * SNAPSHOT_LENGTH == destroyCount);
+
+    snapshot_destroy(&snapshot);
+    assert((size_t)(SNAPSHOT_WRITES + 1) * SNAPSHOT_LENGTH == destroyCount);
+}
+
+int main(void) {
+    array_test();
+    snapshot_test();
     //vec_test();
     //stack_test();
 
@@ -1,4 +1,4 @@
-gcc utils.c array.c test.c -o test
+gcc utils.c bitset.c random.c array.c losertree.c extsort.c snapshot.c test.c -o test -pthread
 ./test
 
 rm test.exe
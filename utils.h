@@ -15,7 +15,10 @@ typedef bool(*predicate_t)(const void*);
 typedef bool(*binary_predicate_t)(const void*, const void*);
 typedef ptrdiff_t(*comparator_t)(const void*, const void*);
 typedef void(*action_t)(void*);
-typedef size_t(*randomizer_t)(void);
+typedef void(*combiner_t)(void*, const void*);
+typedef void(*key_extractor_t)(void*, const void*);
+typedef void(*batch_predicate_t)(const void*, const size_t, const size_t, bool*);
+typedef void(*batch_action_t)(void*, const size_t, const size_t);
 
 typedef struct {
     size_t itemSize;
@@ -40,6 +43,11 @@ typedef struct {
     char* high;
 } range_t;
 
+typedef struct {
+    const void* min;
+    const void* max;
+} minmax_t;
+
 void ptr_swap(void*, void*, void*, const size_t);
 
 